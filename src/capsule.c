@@ -0,0 +1,529 @@
+/*
+ * DF2 Capsules (Swept Disks)
+ *
+ * A disk of radius r swept along a segment A-B is a capsule: a half-circle
+ * around B, a half-circle around A, joined by the two tangent lines.  The
+ * two half-circles are point reflections of each other, so one DF2 walk of
+ * the half-circle offsets o(theta), theta in [d - 90deg, d + 90deg] with d
+ * the segment direction, yields both:
+ *
+ *   B + o(theta)   and   A - o(theta)
+ *
+ * The start phase comes from the segment vector itself (cos d = dx/len),
+ * so per capsule there is one sqrt and no trig; only cos/sin(omega) depend
+ * on r and are cached across a batch.
+ *
+ * Filled capsules record each row's left/right extent from the boundary
+ * and then fill every row once.  Compared against stamping filled disks
+ * every pixel along the segment.
+ *
+ * Compile: gcc -O3 -o capsule capsule.c -lm
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <stdint.h>
+#include <float.h>
+
+/*===========================================================================
+ * Framebuffer
+ *===========================================================================*/
+
+typedef struct {
+    int width, height;
+    uint8_t *pixels;
+} Framebuffer;
+
+Framebuffer* fb_create(int w, int h) {
+    Framebuffer *fb = malloc(sizeof(Framebuffer));
+    fb->width = w;
+    fb->height = h;
+    fb->pixels = calloc(w * h, 1);
+    return fb;
+}
+
+void fb_clear(Framebuffer *fb) {
+    memset(fb->pixels, 0, fb->width * fb->height);
+}
+
+void fb_free(Framebuffer *fb) {
+    free(fb->pixels);
+    free(fb);
+}
+
+static inline void fb_plot(Framebuffer *fb, int x, int y) {
+    x += fb->width / 2;
+    y += fb->height / 2;
+    if (x >= 0 && x < fb->width && y >= 0 && y < fb->height) {
+        fb->pixels[y * fb->width + x] = 1;
+    }
+}
+
+/* Pixels x0..x1 inclusive on row y, centre-relative like fb_plot */
+static inline void fb_span(Framebuffer *fb, int y, int x0, int x1) {
+    y += fb->height / 2;
+    x0 += fb->width / 2;
+    x1 += fb->width / 2;
+    if (y < 0 || y >= fb->height) return;
+    if (x0 < 0) x0 = 0;
+    if (x1 >= fb->width) x1 = fb->width - 1;
+    if (x0 <= x1) memset(fb->pixels + y * fb->width + x0, 1, x1 - x0 + 1);
+}
+
+int fb_count_pixels(Framebuffer *fb) {
+    int count = 0;
+    for (int i = 0; i < fb->width * fb->height; i++) {
+        count += fb->pixels[i];
+    }
+    return count;
+}
+
+int fb_diff_pixels(Framebuffer *a, Framebuffer *b) {
+    int count = 0;
+    for (int i = 0; i < a->width * a->height; i++) {
+        count += a->pixels[i] != b->pixels[i];
+    }
+    return count;
+}
+
+void fb_print(Framebuffer *fb, const char *title) {
+    printf("\n%s:\n", title);
+    for (int y = 0; y < fb->height; y++) {
+        for (int x = 0; x < fb->width; x++) {
+            putchar(fb->pixels[y * fb->width + x] ? '#' : ' ');
+        }
+        putchar('\n');
+    }
+}
+
+/*===========================================================================
+ * Capsules and Scratch Space
+ *===========================================================================*/
+
+typedef struct {
+    double x0, y0, x1, y1;  /* segment A-B, centre-relative pixels */
+    double r;
+} Capsule;
+
+typedef struct {
+    double *ox, *oy;        /* half-circle offsets */
+    int off_cap;
+    double *xl, *xr;        /* per-row extents */
+    int row_cap;
+    double r;               /* radius the cached coefficients belong to */
+    double cos_w, sin_w, omega;
+} CapsuleScratch;
+
+void scratch_init(CapsuleScratch *s) {
+    memset(s, 0, sizeof(*s));
+    s->r = -1;
+}
+
+void scratch_free(CapsuleScratch *s) {
+    free(s->ox);
+    free(s->oy);
+    free(s->xl);
+    free(s->xr);
+    scratch_init(s);
+}
+
+/*===========================================================================
+ * DF2 Half-Circle Walk
+ *
+ * Offsets o_i = r * (cos t_i, sin t_i), t_i = d - 90deg + i * omega, with the
+ * sine recovered from adjacent samples at the same angle:
+ *   r sin(t) = (w[n-2] - w[n-1] cos(omega)) / sin(omega)
+ * The final offset is set exactly to -o_0 so that the arcs meet the
+ * tangent lines without a gap.  Returns the number of offsets.
+ *===========================================================================*/
+
+static int df2_half_circle(const Capsule *c, CapsuleScratch *s) {
+    double r = c->r;
+
+    if (r != s->r) {
+        s->r = r;
+        s->omega = 1.0 / (1.5 * (r > 1.0 ? r : 1.0));
+        s->cos_w = cos(s->omega);
+        s->sin_w = sin(s->omega);
+    }
+
+    int n = (int)(M_PI / s->omega) + 2;
+    if (n > s->off_cap) {
+        s->off_cap = n;
+        s->ox = realloc(s->ox, n * sizeof(double));
+        s->oy = realloc(s->oy, n * sizeof(double));
+    }
+
+    /* Direction d from the segment; degenerate segments point along +x */
+    double dx = c->x1 - c->x0, dy = c->y1 - c->y0;
+    double len = sqrt(dx * dx + dy * dy);
+    double cd = len > 0 ? dx / len : 1.0;
+    double sd = len > 0 ? dy / len : 0.0;
+
+    /* Start angle a = d - 90deg: cos a = sin d, sin a = -cos d */
+    double ca = sd, sa = -cd;
+    double cw = s->cos_w, sw = s->sin_w;
+    double coeff = 2.0 * cw, inv_sw = 1.0 / sw;
+
+    double w1 = r * ca;                     /* r cos(a) */
+    double w0 = r * (ca * cw + sa * sw);    /* r cos(a - omega) */
+
+    s->ox[0] = r * ca;
+    s->oy[0] = r * sa;
+    for (int i = 1; i < n - 1; i++) {
+        double w2 = coeff * w1 - w0;
+        w0 = w1;
+        w1 = w2;
+        s->ox[i] = w1;
+        s->oy[i] = (w0 - w1 * cw) * inv_sw;
+    }
+    s->ox[n - 1] = -s->ox[0];
+    s->oy[n - 1] = -s->oy[0];
+
+    return n;
+}
+
+/*===========================================================================
+ * ALGORITHM 1: DF2 Capsule Outline
+ *===========================================================================*/
+
+static void line_dda(Framebuffer *fb, double x0, double y0, double x1, double y1) {
+    double dx = x1 - x0, dy = y1 - y0;
+    int steps = (int)ceil(fmax(fabs(dx), fabs(dy)));
+    if (steps == 0) steps = 1;
+    double sx = dx / steps, sy = dy / steps;
+    for (int i = 0; i <= steps; i++) {
+        fb_plot(fb, (int)lround(x0), (int)lround(y0));
+        x0 += sx;
+        y0 += sy;
+    }
+}
+
+void capsule_outline(Framebuffer *fb, const Capsule *c, CapsuleScratch *s) {
+    if (c->r <= 0) return;
+
+    int n = df2_half_circle(c, s);
+    const double *ox = s->ox, *oy = s->oy;
+
+    for (int i = 0; i < n; i++) {
+        fb_plot(fb, (int)lround(c->x1 + ox[i]), (int)lround(c->y1 + oy[i]));
+        fb_plot(fb, (int)lround(c->x0 - ox[i]), (int)lround(c->y0 - oy[i]));
+    }
+
+    /* Tangent spans: B + o_last -> A - o_0 and A - o_last -> B + o_0 */
+    line_dda(fb, c->x1 + ox[n - 1], c->y1 + oy[n - 1], c->x0 - ox[0], c->y0 - oy[0]);
+    line_dda(fb, c->x0 - ox[n - 1], c->y0 - oy[n - 1], c->x1 + ox[0], c->y1 + oy[0]);
+}
+
+/*===========================================================================
+ * ALGORITHM 2: DF2 Filled Capsule
+ *
+ * Each half-circle is bounded by the polygon circumscribing it rather than
+ * by its chords: the walk points o_i and o_i+1 are replaced by the corner
+ * where the circle's tangents at those points meet,
+ *
+ *   t_i = (o_i + o_i+1) * r^2 / (r^2 + o_i . o_i+1)
+ *
+ * which lies at radius r / cos(step/2).  Chords sit inside the arc by up to
+ * the sagitta r(1 - cos(omega/2)) and would drop every pixel at exactly
+ * distance r, such as the cap tips of axis-aligned capsules.  The outer
+ * polygon contains the disk, touches it at every o_i, and overshoots only
+ * near its corners, by at most r(1/cos(omega/2) - 1) ~ 1/(18r) px.  The end
+ * points o_0 and o_last are kept, so the tangent spans joining the two caps
+ * stay exactly r from the segment.
+ *
+ * The resulting boundary is convex, so every row crossing it has one
+ * interval.  Each edge updates the extents of the rows whose pixel centres
+ * (integer y) it spans; then each row is filled once.
+ *===========================================================================*/
+
+static inline void edge_extents(double px, double py, double qx, double qy,
+                                int y_base, double *xl, double *xr) {
+    if (py == qy) return;
+    if (py > qy) {
+        double t = px; px = qx; qx = t;
+        t = py; py = qy; qy = t;
+    }
+
+    int y0 = (int)ceil(py), y1 = (int)floor(qy);
+    double slope = (qx - px) / (qy - py);
+    for (int y = y0; y <= y1; y++) {
+        double x = px + (y - py) * slope;
+        int row = y - y_base;
+        if (x < xl[row]) xl[row] = x;
+        if (x > xr[row]) xr[row] = x;
+    }
+}
+
+/* Corner of the tangents at o_i and o_j, relative to the cap centre */
+static inline void tangent_corner(double xi, double yi, double xj, double yj,
+                                  double r2, double *tx, double *ty) {
+    double k = r2 / (r2 + xi * xj + yi * yj);
+    *tx = (xi + xj) * k;
+    *ty = (yi + yj) * k;
+}
+
+void capsule_fill(Framebuffer *fb, const Capsule *c, CapsuleScratch *s) {
+    if (c->r <= 0) return;
+
+    int n = df2_half_circle(c, s);
+    const double *ox = s->ox, *oy = s->oy;
+    double r2 = c->r * c->r;
+
+    /* Corners reach r / cos(omega/2); leave a row of margin for them */
+    int y_base = (int)floor(fmin(c->y0, c->y1) - c->r) - 1;
+    int rows = (int)ceil(fmax(c->y0, c->y1) + c->r) + 1 - y_base + 1;
+    if (rows > s->row_cap) {
+        s->row_cap = rows;
+        s->xl = realloc(s->xl, rows * sizeof(double));
+        s->xr = realloc(s->xr, rows * sizeof(double));
+    }
+    double *xl = s->xl, *xr = s->xr;
+    for (int i = 0; i < rows; i++) {
+        xl[i] = DBL_MAX;
+        xr[i] = -DBL_MAX;
+    }
+
+    /* Arc around B, tangent to A, arc around A, tangent back to B */
+    double px = c->x1 + ox[0], py = c->y1 + oy[0];
+    for (int i = 0; i < n - 1; i++) {
+        double tx, ty;
+        tangent_corner(ox[i], oy[i], ox[i + 1], oy[i + 1], r2, &tx, &ty);
+        double qx = c->x1 + tx, qy = c->y1 + ty;
+        edge_extents(px, py, qx, qy, y_base, xl, xr);
+        px = qx;
+        py = qy;
+    }
+    double qx = c->x1 + ox[n - 1], qy = c->y1 + oy[n - 1];
+    edge_extents(px, py, qx, qy, y_base, xl, xr);
+    px = c->x0 - ox[0];
+    py = c->y0 - oy[0];
+    edge_extents(qx, qy, px, py, y_base, xl, xr);
+    for (int i = 0; i < n - 1; i++) {
+        double tx, ty;
+        tangent_corner(ox[i], oy[i], ox[i + 1], oy[i + 1], r2, &tx, &ty);
+        qx = c->x0 - tx;
+        qy = c->y0 - ty;
+        edge_extents(px, py, qx, qy, y_base, xl, xr);
+        px = qx;
+        py = qy;
+    }
+    qx = c->x0 - ox[n - 1];
+    qy = c->y0 - oy[n - 1];
+    edge_extents(px, py, qx, qy, y_base, xl, xr);
+    edge_extents(qx, qy, c->x1 + ox[0], c->y1 + oy[0], y_base, xl, xr);
+
+    for (int i = 0; i < rows; i++) {
+        if (xl[i] > xr[i]) continue;
+        fb_span(fb, y_base + i, (int)ceil(xl[i]), (int)floor(xr[i]));
+    }
+}
+
+/* Batch submission: one scratch, coefficients reused while r repeats */
+void capsule_fill_batch(Framebuffer *fb, const Capsule *caps, int count,
+                        CapsuleScratch *s) {
+    for (int i = 0; i < count; i++) capsule_fill(fb, &caps[i], s);
+}
+
+void capsule_outline_batch(Framebuffer *fb, const Capsule *caps, int count,
+                           CapsuleScratch *s) {
+    for (int i = 0; i < count; i++) capsule_outline(fb, &caps[i], s);
+}
+
+/*===========================================================================
+ * ALGORITHM 3: Stamped Disks (baseline)
+ *
+ * Filled disks every STAMP_SPACING pixels along the segment, each filled
+ * row by row from sqrt(r^2 - dy^2).
+ *===========================================================================*/
+
+#define STAMP_SPACING 1.0
+
+static void disk_fill(Framebuffer *fb, double cx, double cy, double r) {
+    int y0 = (int)ceil(cy - r), y1 = (int)floor(cy + r);
+    for (int y = y0; y <= y1; y++) {
+        double dy = y - cy;
+        double hw = sqrt(r * r - dy * dy);
+        fb_span(fb, y, (int)ceil(cx - hw), (int)floor(cx + hw));
+    }
+}
+
+void capsule_stamp(Framebuffer *fb, const Capsule *c) {
+    if (c->r <= 0) return;
+
+    double dx = c->x1 - c->x0, dy = c->y1 - c->y0;
+    int stamps = (int)ceil(sqrt(dx * dx + dy * dy) / STAMP_SPACING);
+    for (int i = 0; i <= stamps; i++) {
+        double t = stamps ? (double)i / stamps : 0.0;
+        disk_fill(fb, c->x0 + t * dx, c->y0 + t * dy, c->r);
+    }
+}
+
+/*===========================================================================
+ * Timing Utilities
+ *===========================================================================*/
+
+double get_time_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/*===========================================================================
+ * Main
+ *===========================================================================*/
+
+int main(void) {
+    printf("================================================================\n");
+    printf("  DF2 Capsules (Swept Disks)\n");
+    printf("  One half-circle walk, two arcs, each row filled once\n");
+    printf("================================================================\n\n");
+
+    CapsuleScratch scr;
+    scratch_init(&scr);
+
+    /* Visual comparison */
+    printf("VISUAL COMPARISON (r=5, A=(-12,-4), B=(12,5)):\n");
+    printf("----------------------------------------------------------------\n");
+
+    Framebuffer *fb = fb_create(40, 24);
+    Capsule demo = { -12, -4, 12, 5, 5 };
+
+    capsule_outline(fb, &demo, &scr);
+    fb_print(fb, "DF2 capsule outline");
+
+    fb_clear(fb);
+    capsule_fill(fb, &demo, &scr);
+    fb_print(fb, "DF2 filled capsule");
+
+    fb_free(fb);
+
+    /* Single capsules */
+    printf("\n\nSINGLE CAPSULE:\n");
+    printf("================================================================\n");
+    printf("%-18s %10s %10s %10s %8s %8s %7s\n", "Capsule", "Outline",
+           "Fill(us)", "Stamp(us)", "Stamps", "Pixels", "Diff");
+    printf("----------------------------------------------------------------\n");
+
+    Capsule singles[] = {
+        {-25, -3, 25, 4, 4},
+        {-50, -20, 50, 20, 8},
+        {-100, 10, 100, -10, 16},
+        {-50, -50, 50, 50, 32},
+        {-10, 0, 10, 0, 6},
+        {0, 0, 0, 0, 10}
+    };
+    const char *single_names[] = {"r=4 len=50", "r=8 len=108",
+                                  "r=16 len=201", "r=32 len=141",
+                                  "r=6 len=20 axis", "r=10 len=0"};
+    int num_singles = sizeof(singles) / sizeof(singles[0]);
+    int failures = 0;
+
+    for (int i = 0; i < num_singles; i++) {
+        const Capsule *c = &singles[i];
+        Framebuffer *a = fb_create(300, 200);
+        Framebuffer *b = fb_create(300, 200);
+        int iterations = 20000;
+
+        double t0 = get_time_ns();
+        for (int k = 0; k < iterations; k++) capsule_outline(a, c, &scr);
+        double t_outline = (get_time_ns() - t0) / iterations / 1000.0;
+
+        t0 = get_time_ns();
+        for (int k = 0; k < iterations; k++) capsule_fill(a, c, &scr);
+        double t_fill = (get_time_ns() - t0) / iterations / 1000.0;
+
+        t0 = get_time_ns();
+        for (int k = 0; k < iterations / 10; k++) capsule_stamp(b, c);
+        double t_stamp = (get_time_ns() - t0) / (iterations / 10) / 1000.0;
+
+        fb_clear(a);
+        fb_clear(b);
+        capsule_fill(a, c, &scr);
+        capsule_stamp(b, c);
+
+        double len = hypot(c->x1 - c->x0, c->y1 - c->y0);
+        int diff = fb_diff_pixels(a, b);
+        failures += diff != 0;
+        printf("%-18s %10.2f %10.2f %10.2f %8d %8d %7d\n", single_names[i],
+               t_outline, t_fill, t_stamp, (int)ceil(len / STAMP_SPACING) + 1,
+               fb_count_pixels(a), diff);
+
+        fb_free(a);
+        fb_free(b);
+    }
+
+    /* Batch: motion-blurred particles */
+    printf("\n\nBATCH (10000 motion-blurred particles, r = 3 or 5, len 5..40):\n");
+    printf("================================================================\n");
+    printf("%-28s %12s %14s\n", "Method", "Time(ms)", "Particles/sec");
+    printf("----------------------------------------------------------------\n");
+
+    int count = 10000;
+    Capsule *caps = malloc(count * sizeof(Capsule));
+    srand(4242);
+    for (int i = 0; i < count; i++) {
+        double x = rand() % 900 - 450, y = rand() % 500 - 250;
+        double ang = (rand() % 3600) * (M_PI / 1800.0);
+        double len = 5 + rand() % 36;
+        caps[i].x0 = x;
+        caps[i].y0 = y;
+        caps[i].x1 = x + len * cos(ang);
+        caps[i].y1 = y + len * sin(ang);
+        caps[i].r = (i & 1) ? 5 : 3;
+    }
+
+    /* Sorting by radius lets the batch keep cos/sin(omega) cached */
+    Capsule *sorted = malloc(count * sizeof(Capsule));
+    int m = 0;
+    for (int i = 0; i < count; i += 2) sorted[m++] = caps[i];
+    for (int i = 1; i < count; i += 2) sorted[m++] = caps[i];
+
+    fb = fb_create(1000, 600);
+    double t0, ms;
+
+    t0 = get_time_ns();
+    for (int i = 0; i < count; i++) {
+        CapsuleScratch fresh;
+        scratch_init(&fresh);
+        capsule_fill(fb, &caps[i], &fresh);
+        scratch_free(&fresh);
+    }
+    ms = (get_time_ns() - t0) / 1e6;
+    printf("%-28s %12.2f %14.0f\n", "DF2 fill, one call each", ms, count / (ms / 1000));
+
+    t0 = get_time_ns();
+    capsule_fill_batch(fb, caps, count, &scr);
+    ms = (get_time_ns() - t0) / 1e6;
+    printf("%-28s %12.2f %14.0f\n", "DF2 fill, batch", ms, count / (ms / 1000));
+
+    t0 = get_time_ns();
+    capsule_fill_batch(fb, sorted, count, &scr);
+    ms = (get_time_ns() - t0) / 1e6;
+    printf("%-28s %12.2f %14.0f\n", "DF2 fill, batch by radius", ms, count / (ms / 1000));
+
+    t0 = get_time_ns();
+    capsule_outline_batch(fb, sorted, count, &scr);
+    ms = (get_time_ns() - t0) / 1e6;
+    printf("%-28s %12.2f %14.0f\n", "DF2 outline, batch by radius", ms, count / (ms / 1000));
+
+    t0 = get_time_ns();
+    for (int i = 0; i < count; i++) capsule_stamp(fb, &caps[i]);
+    ms = (get_time_ns() - t0) / 1e6;
+    printf("%-28s %12.2f %14.0f\n", "Stamped disks", ms, count / (ms / 1000));
+
+    fb_free(fb);
+    free(sorted);
+    free(caps);
+    scratch_free(&scr);
+
+    printf("\n\nCONCLUSION:\n");
+    printf("================================================================\n");
+    printf("A capsule costs one half-circle walk and one pass over its rows,\n");
+    printf("independent of length; stamping grows with length times area.\n");
+
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,445 @@
+/*
+ * DF2 Dashed and Dotted Circles
+ *
+ * The DF2 walk advances in uniform angle steps, so every iteration covers
+ * the same arc length (r * omega = 2/3 pixel).  A dash pattern expressed in
+ * steps can therefore be applied with a step counter: one compare and one
+ * wrap per point, no arc-length arithmetic, no extra branches.
+ *
+ * The walks run in float64.  Q16.16 loses the recurrence above its
+ * critical radius (~120 px, see df2_benchmark), and dashed range rings
+ * are routinely larger than that.
+ *
+ * Compile: gcc -O3 -o dashed_circle dashed_circle.c -lm
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <stdint.h>
+
+/*===========================================================================
+ * Framebuffer
+ *===========================================================================*/
+
+typedef struct {
+    int width, height;
+    uint8_t *pixels;
+} Framebuffer;
+
+Framebuffer* fb_create(int w, int h) {
+    Framebuffer *fb = malloc(sizeof(Framebuffer));
+    fb->width = w;
+    fb->height = h;
+    fb->pixels = calloc(w * h, 1);
+    return fb;
+}
+
+void fb_clear(Framebuffer *fb) {
+    memset(fb->pixels, 0, fb->width * fb->height);
+}
+
+void fb_free(Framebuffer *fb) {
+    free(fb->pixels);
+    free(fb);
+}
+
+int fb_count_pixels(Framebuffer *fb) {
+    int count = 0;
+    for (int i = 0; i < fb->width * fb->height; i++) {
+        count += fb->pixels[i];
+    }
+    return count;
+}
+
+void fb_print(Framebuffer *fb, const char *title) {
+    printf("\n%s:\n", title);
+    for (int y = 0; y < fb->height; y++) {
+        for (int x = 0; x < fb->width; x++) {
+            putchar(fb->pixels[y * fb->width + x] ? '#' : ' ');
+        }
+        putchar('\n');
+    }
+}
+
+/*===========================================================================
+ * Dash Patterns
+ *
+ * A pattern is a period of 'len' counter units of which the first 'on' are
+ * drawn.  A counter k advances DASH_STEP units per DF2 step; the store ORs
+ * in (k < on) and k wraps by subtracting len under a (k >= len) mask.  Both
+ * compile to setcc sequences (gcc -O3, x86-64), so the pattern adds no
+ * branch.  Lengths are given in pixels of arc; a DF2 step covers 2/3 px
+ * (omega = 1/(1.5 r)), so a pixel is DASH_UNITS_PER_PIXEL units and a
+ * period is kept to 1/384 px.  The fraction of a step left over at each
+ * wrap carries into the next period: dots every 3 px at r=50 land 3 px
+ * apart on average, not at a step-rounded 3.33 px.  Individual dashes and
+ * gaps still start and end on whole steps.
+ *===========================================================================*/
+
+#define STEPS_PER_PIXEL 1.5
+#define DASH_STEP 256
+#define DASH_UNITS_PER_PIXEL (DASH_STEP * STEPS_PER_PIXEL)
+
+typedef struct {
+    int on;
+    int len;
+    int phase;      /* counter value at the first step */
+} DashPattern;
+
+static inline int dash_advance(int k, int len) {
+    k += DASH_STEP;
+    return k - (len & -(k >= len));
+}
+
+/* At least one step, so every dash draws and every gap skips */
+static int px_to_units(double px) {
+    int units = (int)lrint(px * DASH_UNITS_PER_PIXEL);
+    return units < DASH_STEP ? DASH_STEP : units;
+}
+
+/* 'on' pixels drawn, 'off' pixels skipped, pattern advanced by 'phase' pixels */
+DashPattern dash_pattern(double on_px, double off_px, double phase_px) {
+    DashPattern p;
+    p.on = px_to_units(on_px);
+    p.len = p.on + px_to_units(off_px);
+
+    p.phase = (int)(lrint(phase_px * DASH_UNITS_PER_PIXEL) % p.len);
+    if (p.phase < 0) p.phase += p.len;
+    return p;
+}
+
+/* One-step dots every 'spacing' pixels of arc */
+DashPattern dot_pattern(double spacing_px, double phase_px) {
+    return dash_pattern(1.0 / STEPS_PER_PIXEL,
+                        spacing_px - 1.0 / STEPS_PER_PIXEL, phase_px);
+}
+
+/*===========================================================================
+ * ALGORITHM 1: DF2 Full Circle - Solid (reference)
+ *===========================================================================*/
+
+int circle_df2_solid(Framebuffer *fb, int cx, int cy, int r) {
+    if (r <= 0) return 0;
+
+    double omega = 1.0 / (1.5 * r);
+    double coeff = 2.0 * cos(omega);
+    double scale = -1.0 / omega;
+    double w0 = r * cos(omega);
+    double w1 = r;
+    int steps = (int)(2.0 * M_PI / omega) + 1;
+
+    int ox = cx + fb->width / 2, oy = cy + fb->height / 2;
+
+    for (int i = 0; i < steps; i++) {
+        int px = ox + (int)lrint(w1);
+        int py = oy + (int)lrint((w1 - w0) * scale);
+        if (px >= 0 && px < fb->width && py >= 0 && py < fb->height) {
+            fb->pixels[py * fb->width + px] = 1;
+        }
+        double w2 = coeff * w1 - w0;
+        w0 = w1;
+        w1 = w2;
+    }
+
+    return steps;
+}
+
+/*===========================================================================
+ * ALGORITHM 2: DF2 Full Circle - Dashed / Dotted
+ *
+ * Identical walk; the store ORs in the pattern's on test instead of 1, so
+ * gaps cost exactly as much as dashes and the loop stays branch-free.
+ *===========================================================================*/
+
+int circle_df2_dashed(Framebuffer *fb, int cx, int cy, int r,
+                      const DashPattern *pat) {
+    if (r <= 0) return 0;
+
+    double omega = 1.0 / (1.5 * r);
+    double coeff = 2.0 * cos(omega);
+    double scale = -1.0 / omega;
+    double w0 = r * cos(omega);
+    double w1 = r;
+    int steps = (int)(2.0 * M_PI / omega) + 1;
+
+    int ox = cx + fb->width / 2, oy = cy + fb->height / 2;
+    int k = pat->phase, on = pat->on, len = pat->len;
+
+    for (int i = 0; i < steps; i++) {
+        int px = ox + (int)lrint(w1);
+        int py = oy + (int)lrint((w1 - w0) * scale);
+        if (px >= 0 && px < fb->width && py >= 0 && py < fb->height) {
+            fb->pixels[py * fb->width + px] |= (uint8_t)(k < on);
+        }
+        k = dash_advance(k, len);
+        double w2 = coeff * w1 - w0;
+        w0 = w1;
+        w1 = w2;
+    }
+
+    return steps;
+}
+
+/*===========================================================================
+ * ALGORITHM 3: DF2 Arc - Solid and Dashed
+ *
+ * Start phase is set by seeding w[n-1] = r*cos(a0), w[n-2] = r*cos(a0 - omega);
+ * angles are counter-clockwise in radians.  The dash pattern starts at a0.
+ *===========================================================================*/
+
+int arc_df2_dashed(Framebuffer *fb, int cx, int cy, int r,
+                   double start, double sweep, const DashPattern *pat) {
+    if (r <= 0 || sweep <= 0) return 0;
+
+    double omega = 1.0 / (1.5 * r);
+    double coeff = 2.0 * cos(omega);
+    double scale = -1.0 / omega;
+    double w0 = r * cos(start - omega);
+    double w1 = r * cos(start);
+    int steps = (int)(sweep / omega) + 1;
+
+    int ox = cx + fb->width / 2, oy = cy + fb->height / 2;
+    int k = pat->phase, on = pat->on, len = pat->len;
+
+    for (int i = 0; i < steps; i++) {
+        int px = ox + (int)lrint(w1);
+        int py = oy + (int)lrint((w1 - w0) * scale);
+        if (px >= 0 && px < fb->width && py >= 0 && py < fb->height) {
+            fb->pixels[py * fb->width + px] |= (uint8_t)(k < on);
+        }
+        k = dash_advance(k, len);
+        double w2 = coeff * w1 - w0;
+        w0 = w1;
+        w1 = w2;
+    }
+
+    return steps;
+}
+
+int arc_df2_solid(Framebuffer *fb, int cx, int cy, int r,
+                  double start, double sweep) {
+    if (r <= 0 || sweep <= 0) return 0;
+
+    double omega = 1.0 / (1.5 * r);
+    double coeff = 2.0 * cos(omega);
+    double scale = -1.0 / omega;
+    double w0 = r * cos(start - omega);
+    double w1 = r * cos(start);
+    int steps = (int)(sweep / omega) + 1;
+
+    int ox = cx + fb->width / 2, oy = cy + fb->height / 2;
+
+    for (int i = 0; i < steps; i++) {
+        int px = ox + (int)lrint(w1);
+        int py = oy + (int)lrint((w1 - w0) * scale);
+        if (px >= 0 && px < fb->width && py >= 0 && py < fb->height) {
+            fb->pixels[py * fb->width + px] = 1;
+        }
+        double w2 = coeff * w1 - w0;
+        w0 = w1;
+        w1 = w2;
+    }
+
+    return steps;
+}
+
+/*===========================================================================
+ * Timing Utilities
+ *===========================================================================*/
+
+double get_time_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/*===========================================================================
+ * Benchmark Infrastructure
+ *===========================================================================*/
+
+typedef enum { SHAPE_CIRCLE, SHAPE_ARC } Shape;
+
+typedef struct {
+    const char *name;
+    Shape shape;
+    int dashed;
+    double on_px, off_px;   /* dot pattern when on_px == 0 */
+} Variant;
+
+#define ARC_START (M_PI / 4)
+#define ARC_SWEEP (1.5 * M_PI)
+
+static void draw_variant(const Variant *v, const DashPattern *pat,
+                         Framebuffer *fb, int r) {
+    if (v->shape == SHAPE_CIRCLE) {
+        if (v->dashed) circle_df2_dashed(fb, 0, 0, r, pat);
+        else circle_df2_solid(fb, 0, 0, r);
+    } else {
+        if (v->dashed) arc_df2_dashed(fb, 0, 0, r, ARC_START, ARC_SWEEP, pat);
+        else arc_df2_solid(fb, 0, 0, r, ARC_START, ARC_SWEEP);
+    }
+}
+
+void run_benchmark(const Variant *v, Framebuffer *fb, int r, int iterations,
+                   double *time_us, int *pixels) {
+    DashPattern pat = v->on_px > 0 ? dash_pattern(v->on_px, v->off_px, 0)
+                                   : dot_pattern(v->off_px, 0);
+    double total = 0;
+
+    for (int i = 0; i < iterations; i++) {
+        fb_clear(fb);
+        double start = get_time_ns();
+        draw_variant(v, &pat, fb, r);
+        double end = get_time_ns();
+        total += (end - start);
+    }
+
+    *pixels = fb_count_pixels(fb);
+    *time_us = (total / iterations) / 1000.0;
+}
+
+/* Largest distance of a drawn pixel from the ideal radius */
+double max_radial_error(Framebuffer *fb, int r) {
+    double max_err = 0;
+    for (int y = 0; y < fb->height; y++) {
+        for (int x = 0; x < fb->width; x++) {
+            if (!fb->pixels[y * fb->width + x]) continue;
+            double d = fabs(hypot(x - fb->width / 2, y - fb->height / 2) - r);
+            if (d > max_err) max_err = d;
+        }
+    }
+    return max_err;
+}
+
+/*===========================================================================
+ * Main
+ *===========================================================================*/
+
+int main(void) {
+    printf("================================================================\n");
+    printf("  DF2 Dashed and Dotted Circles\n");
+    printf("  Dash pattern applied as a counter compare per DF2 step\n");
+    printf("================================================================\n\n");
+
+    /* Visual comparison */
+    printf("VISUAL COMPARISON (radius=14):\n");
+    printf("----------------------------------------------------------------\n");
+
+    Framebuffer *fb = fb_create(34, 34);
+    DashPattern dash = dash_pattern(4, 3, 0);
+    DashPattern dots = dot_pattern(3, 0);
+
+    fb_clear(fb);
+    circle_df2_dashed(fb, 0, 0, 14, &dash);
+    fb_print(fb, "Dashed (4 on, 3 off)");
+
+    fb_clear(fb);
+    dash = dash_pattern(4, 3, 2);
+    circle_df2_dashed(fb, 0, 0, 14, &dash);
+    fb_print(fb, "Dashed (4 on, 3 off, phase 2)");
+
+    fb_clear(fb);
+    circle_df2_dashed(fb, 0, 0, 14, &dots);
+    fb_print(fb, "Dotted (every 3 px)");
+
+    fb_clear(fb);
+    dash = dash_pattern(4, 3, 0);
+    arc_df2_dashed(fb, 0, 0, 14, ARC_START, ARC_SWEEP, &dash);
+    fb_print(fb, "Dashed arc (45 deg + 270 deg)");
+
+    fb_free(fb);
+
+    /* Performance benchmarks */
+    printf("\n\nPERFORMANCE BENCHMARKS:\n");
+    printf("================================================================\n");
+
+    Variant variants[] = {
+        {"Solid circle", SHAPE_CIRCLE, 0, 0, 0},
+        {"Dashed circle (4/3)", SHAPE_CIRCLE, 1, 4, 3},
+        {"Dotted circle (3)", SHAPE_CIRCLE, 1, 0, 3},
+        {"Dashed circle (30/30)", SHAPE_CIRCLE, 1, 30, 30},
+        {"Solid arc (270 deg)", SHAPE_ARC, 0, 0, 0},
+        {"Dashed arc (270 deg, 4/3)", SHAPE_ARC, 1, 4, 3}
+    };
+    int num_variants = sizeof(variants) / sizeof(variants[0]);
+
+    int radii[] = {25, 50, 75, 100};
+    int num_radii = sizeof(radii) / sizeof(radii[0]);
+    int iterations = 20000;
+    double min_ratio = 1e9, max_ratio = 0, sum_ratio = 0;
+    int num_ratios = 0;
+
+    for (int ri = 0; ri < num_radii; ri++) {
+        int r = radii[ri];
+        fb = fb_create(r * 3, r * 3);
+
+        printf("\nRadius = %d:\n", r);
+        printf("%-28s %10s %8s %10s\n",
+               "Variant", "Time(us)", "Pixels", "vs solid");
+        printf("----------------------------------------------------------------\n");
+
+        double solid_circle = 0, solid_arc = 0;
+
+        for (int vi = 0; vi < num_variants; vi++) {
+            double time_us;
+            int pixels;
+
+            run_benchmark(&variants[vi], fb, r, iterations, &time_us, &pixels);
+
+            if (!variants[vi].dashed) {
+                if (variants[vi].shape == SHAPE_CIRCLE) solid_circle = time_us;
+                else solid_arc = time_us;
+            }
+            double base = variants[vi].shape == SHAPE_CIRCLE ? solid_circle
+                                                             : solid_arc;
+
+            printf("%-28s %10.2f %8d %9.2fx\n",
+                   variants[vi].name, time_us, pixels, time_us / base);
+
+            if (variants[vi].dashed) {
+                double ratio = time_us / base;
+                if (ratio < min_ratio) min_ratio = ratio;
+                if (ratio > max_ratio) max_ratio = ratio;
+                sum_ratio += ratio;
+                num_ratios++;
+            }
+        }
+
+        fb_free(fb);
+    }
+
+    /* Accuracy at range-ring sizes */
+    printf("\n\nRADIAL ERROR (pixels):\n");
+    printf("================================================================\n");
+    printf("%-28s %8s %8s %12s\n", "Variant", "Radius", "Pixels", "Max error");
+    printf("----------------------------------------------------------------\n");
+
+    int err_radii[] = {50, 200, 400, 1000};
+    for (int ri = 0; ri < 4; ri++) {
+        int r = err_radii[ri];
+        fb = fb_create(r * 2 + 8, r * 2 + 8);
+        for (int vi = 0; vi < 3; vi++) {
+            const Variant *v = &variants[vi];
+            DashPattern pat = v->on_px > 0 ? dash_pattern(v->on_px, v->off_px, 0)
+                                           : dot_pattern(v->off_px, 0);
+            fb_clear(fb);
+            draw_variant(v, &pat, fb, r);
+            printf("%-28s %8d %8d %12.2f\n", v->name, r,
+                   fb_count_pixels(fb), max_radial_error(fb, r));
+        }
+        fb_free(fb);
+    }
+
+    printf("\n\nCONCLUSION:\n");
+    printf("================================================================\n");
+    printf("Dashes and dots cost one compare per DF2 step and the walk stays\n");
+    printf("branch-free.  Measured here, patterned outlines take %.2fx-%.2fx\n",
+           min_ratio, max_ratio);
+    printf("the time of the matching solid outline (mean %.2fx).\n",
+           sum_ratio / num_ratios);
+
+    return 0;
+}
@@ -3,7 +3,7 @@
  * Supplementary material for "A Direct Form 2 Digital Filter Algorithm 
  * for Circle Rasterization"
  * 
- * Compile: gcc -O3 -o df2_circle_benchmark df2_circle_benchmark.c -lm
+ * Compile: gcc -O3 -o df2_circle_benchmark df2_circle_benchmark.c -lm -ldl
  */
 
 #include <stdio.h>
@@ -12,38 +12,17 @@
 #include <math.h>
 #include <time.h>
 #include <stdint.h>
-
-/*===========================================================================
- * Fixed-Point Arithmetic (Q16.16)
- *===========================================================================*/
-
-#define FP_BITS 16
-#define FP_ONE (1 << FP_BITS)
-#define FP_HALF (1 << (FP_BITS - 1))
-
-typedef int32_t fixed_t;
-
-static inline fixed_t to_fixed(double d) {
-    return (fixed_t)(d * FP_ONE + (d >= 0 ? 0.5 : -0.5));
-}
-
-static inline int fixed_to_int(fixed_t f) {
-    return (f + FP_HALF) >> FP_BITS;
-}
-
-static inline fixed_t fp_mul(fixed_t a, fixed_t b) {
-    return (fixed_t)(((int64_t)a * b) >> FP_BITS);
-}
+#include "df2_kernel.h"
+#include "df2_registry.h"
+#include "df2_lut.h"
 
 /*===========================================================================
  * Framebuffer
+ *
+ * Framebuffer, fb_plot/fb_plot8 and the Q16.16 helpers live in
+ * df2_kernel.h so that loadable kernels draw the same way.
  *===========================================================================*/
 
-typedef struct {
-    int width, height;
-    uint8_t *pixels;
-} Framebuffer;
-
 Framebuffer* fb_create(int w, int h) {
     Framebuffer *fb = malloc(sizeof(Framebuffer));
     fb->width = w;
@@ -61,24 +40,13 @@ void fb_free(Framebuffer *fb) {
     free(fb);
 }
 
-static inline void fb_plot(Framebuffer *fb, int x, int y) {
-    x += fb->width / 2;
-    y += fb->height / 2;
-    if (x >= 0 && x < fb->width && y >= 0 && y < fb->height) {
-        fb->pixels[y * fb->width + x] = 1;
+/* Pixels set in exactly one of two equally sized framebuffers */
+int fb_diff_pixels(Framebuffer *a, Framebuffer *b) {
+    int count = 0;
+    for (int i = 0; i < a->width * a->height; i++) {
+        count += a->pixels[i] != b->pixels[i];
     }
-}
-
-/* 8-way symmetric plot */
-static inline void fb_plot8(Framebuffer *fb, int cx, int cy, int x, int y) {
-    fb_plot(fb, cx + x, cy + y);
-    fb_plot(fb, cx - x, cy + y);
-    fb_plot(fb, cx + x, cy - y);
-    fb_plot(fb, cx - x, cy - y);
-    fb_plot(fb, cx + y, cy + x);
-    fb_plot(fb, cx - y, cy + x);
-    fb_plot(fb, cx + y, cy - x);
-    fb_plot(fb, cx - y, cy - x);
+    return count;
 }
 
 int fb_count_pixels(Framebuffer *fb) {
@@ -264,6 +232,164 @@ int circle_bresenham(Framebuffer *fb, int cx, int cy, int r) {
     return pixels;
 }
 
+/*===========================================================================
+ * Direct-Evaluation Baselines
+ *
+ * The case for DF2 is that one multiply per point beats evaluating sin and
+ * cos per point.  Algorithms 6-9 walk the full circle at the same angles,
+ * theta[n] = n*omega for n < 2*pi/omega + 1, so the recurrence is measured
+ * against direct evaluation on identical point sequences.  To make that
+ * hold, Algorithm 6 recovers the sine at the same angle as the cosine,
+ *   r*sin(n*omega) = (w[n-1] - w[n]*cos(omega)) / sin(omega),
+ * rather than the half-step difference the octant kernels use.
+ *===========================================================================*/
+
+/*===========================================================================
+ * ALGORITHM 6: DF2 Float - Full Circle (reference)
+ *===========================================================================*/
+
+int circle_df2_float_full(Framebuffer *fb, int cx, int cy, int r) {
+    if (r <= 0) return 0;
+    
+    double omega = 1.0 / (1.5 * r);
+    double c = cos(omega);
+    double coeff = 2.0 * c;
+    double inv_s = 1.0 / sin(omega);
+    
+    double w0 = r * c;
+    double w1 = r;
+    
+    int steps = (int)(2.0 * M_PI / omega) + 1;
+    
+    for (int i = 0; i < steps; i++) {
+        int x = (int)round(w1);
+        int y = (int)round((w0 - w1 * c) * inv_s);
+        
+        fb_plot(fb, cx + x, cy + y);
+        
+        double w2 = coeff * w1 - w0;
+        w0 = w1;
+        w1 = w2;
+    }
+    
+    return steps;
+}
+
+/*===========================================================================
+ * ALGORITHM 7: Quarter-Wave Sine Table with Linear Interpolation
+ *
+ * Angles are a 64-bit phase accumulator (2^64 = one turn) whose top 32
+ * bits address the table: the top two select the quadrant, the next
+ * LUT_BITS index the table, and the rest interpolate.  cos(p) = sin(p +
+ * quarter turn).  A 32-bit accumulator would quantize the step itself:
+ * its error of up to 2^-33 turn per step, over 9.4r steps, drifts the
+ * last point by up to 7e-9 r^2 px, a visible gap from r ~ 10^4.  At 64
+ * bits the step is as exact as the double it is computed from.
+ *
+ * The table (df2_lut.h) is built once by registry_add_builtins(), before
+ * any kernel is timed or dispatched.
+ *===========================================================================*/
+
+int circle_lut_full(Framebuffer *fb, int cx, int cy, int r) {
+    if (r <= 0) return 0;
+    
+    double omega = 1.0 / (1.5 * r);
+    uint64_t dphase = (uint64_t)(omega / (2.0 * M_PI) * 18446744073709551616.0 + 0.5);
+    int steps = (int)(2.0 * M_PI / omega) + 1;
+    
+    uint64_t phase = 0;
+    for (int i = 0; i < steps; i++) {
+        uint32_t p = (uint32_t)(phase >> 32);
+        int x = (int)round(r * lut_sin(p + 0x40000000u));
+        int y = (int)round(r * lut_sin(p));
+        
+        fb_plot(fb, cx + x, cy + y);
+        phase += dphase;
+    }
+    
+    return steps;
+}
+
+/*===========================================================================
+ * ALGORITHM 8: Vectorized Polynomial sincos over Blocks of Angles
+ *
+ * Cody-Waite reduction to t in [-pi/4, pi/4] and quadrant q, then Taylor
+ * polynomials through t^13 (sin) and t^14 (cos), error below 1e-13.  The
+ * block loop is branch-free so the compiler vectorizes it; quadrant fixups
+ * are selects.
+ *===========================================================================*/
+
+#define SINCOS_BLOCK 16
+
+static void sincos_poly_block(const double *theta, double *s, double *c, int n) {
+    const double two_over_pi = 0.63661977236758134308;
+    const double pio2_hi = 1.57079632673412561417;    /* pi/2 upper 33 bits */
+    const double pio2_lo = 6.07710050650619224932e-11;
+    const double round_magic = 6755399441055744.0;    /* 1.5 * 2^52 */
+    
+    for (int i = 0; i < n; i++) {
+        double qd = (theta[i] * two_over_pi + round_magic) - round_magic;
+        double t = (theta[i] - qd * pio2_hi) - qd * pio2_lo;
+        int q = (int)qd;
+        
+        double t2 = t * t;
+        double sp = t + t * t2 * (-1.0 / 6 + t2 * (1.0 / 120 + t2 * (-1.0 / 5040
+                  + t2 * (1.0 / 362880 + t2 * (-1.0 / 39916800
+                  + t2 * (1.0 / 6227020800.0))))));
+        double cp = 1.0 + t2 * (-0.5 + t2 * (1.0 / 24 + t2 * (-1.0 / 720
+                  + t2 * (1.0 / 40320 + t2 * (-1.0 / 3628800
+                  + t2 * (1.0 / 479001600 + t2 * (-1.0 / 87178291200.0)))))));
+        
+        double ss = (q & 1) ? cp : sp;
+        double cc = (q & 1) ? sp : cp;
+        s[i] = (q & 2) ? -ss : ss;
+        c[i] = ((q + 1) & 2) ? -cc : cc;
+    }
+}
+
+int circle_poly_full(Framebuffer *fb, int cx, int cy, int r) {
+    if (r <= 0) return 0;
+    
+    double omega = 1.0 / (1.5 * r);
+    int steps = (int)(2.0 * M_PI / omega) + 1;
+    
+    double theta[SINCOS_BLOCK], s[SINCOS_BLOCK], c[SINCOS_BLOCK];
+    
+    for (int base = 0; base < steps; base += SINCOS_BLOCK) {
+        int n = steps - base < SINCOS_BLOCK ? steps - base : SINCOS_BLOCK;
+        for (int j = 0; j < SINCOS_BLOCK; j++) theta[j] = (base + j) * omega;
+        
+        sincos_poly_block(theta, s, c, SINCOS_BLOCK);
+        
+        for (int j = 0; j < n; j++) {
+            fb_plot(fb, cx + (int)round(r * c[j]), cy + (int)round(r * s[j]));
+        }
+    }
+    
+    return steps;
+}
+
+/*===========================================================================
+ * ALGORITHM 9: Per-Point libm sin/cos (accuracy reference)
+ *===========================================================================*/
+
+int circle_sincos_full(Framebuffer *fb, int cx, int cy, int r) {
+    if (r <= 0) return 0;
+    
+    double omega = 1.0 / (1.5 * r);
+    int steps = (int)(2.0 * M_PI / omega) + 1;
+    
+    for (int i = 0; i < steps; i++) {
+        double theta = i * omega;
+        int x = (int)round(r * cos(theta));
+        int y = (int)round(r * sin(theta));
+        
+        fb_plot(fb, cx + x, cy + y);
+    }
+    
+    return steps;
+}
+
 /*===========================================================================
  * Timing Utilities
  *===========================================================================*/
@@ -278,11 +404,6 @@ double get_time_ns(void) {
  * Benchmark Infrastructure
  *===========================================================================*/
 
-typedef struct {
-    const char *name;
-    int (*func)(Framebuffer*, int, int, int);
-} Algorithm;
-
 void run_benchmark(Algorithm *alg, Framebuffer *fb, int r, int iterations,
                    double *time_us, int *pixels) {
     double total = 0;
@@ -300,6 +421,52 @@ void run_benchmark(Algorithm *alg, Framebuffer *fb, int r, int iterations,
     *time_us = (total / iterations) / 1000.0;
 }
 
+/*===========================================================================
+ * Kernel Registry
+ *
+ * Built-in kernels are registered first, then any shared objects named on
+ * the command line (--kernel PATH) or in DF2_KERNELS (colon-separated).
+ * Capabilities decide which kernels run at which radius.  Timings recorded
+ * per radius bucket by the benchmark drive registry_select().
+ *===========================================================================*/
+
+/* r_crit ~ 0.47 * 2^(bits/2): where 2*cos(omega) is no longer representable */
+static int critical_radius(int frac_bits) {
+    return (int)(0.47 * pow(2.0, frac_bits / 2.0) + 0.5);
+}
+
+void registry_add_builtins(Registry *reg) {
+    sin_lut_init();
+
+    int q16 = critical_radius(FP_BITS);
+    int f64 = critical_radius(52);
+
+    Algorithm builtins[] = {
+        {"DF2 Float", circle_df2_float_sym8,
+         DF2_PREC_FLOAT64, 1, f64, DF2_ISA_NONE, 8},
+        {"DF2 Fixed (Q16.16)", circle_df2_fixed_sym8,
+         DF2_PREC_Q16_16, 1, q16, DF2_ISA_NONE, 8},
+        {"Coupled Float", circle_coupled_float_sym8,
+         DF2_PREC_FLOAT64, 1, 0, DF2_ISA_NONE, 8},
+        {"Coupled Fixed (Q16.16)", circle_coupled_fixed_sym8,
+         DF2_PREC_Q16_16, 1, 32767, DF2_ISA_NONE, 8},
+        {"Bresenham", circle_bresenham,
+         DF2_PREC_INT, 1, 0, DF2_ISA_NONE, 8},
+        {"DF2 Float (full)", circle_df2_float_full,
+         DF2_PREC_FLOAT64, 1, f64, DF2_ISA_NONE, 1},
+        {"Sine LUT (full)", circle_lut_full,
+         DF2_PREC_FLOAT64, 1, LUT_MAX_RADIUS, DF2_ISA_NONE, 1},
+        {"Poly sincos (full)", circle_poly_full,
+         DF2_PREC_FLOAT64, 1, 0, DF2_ISA_NONE, 1},
+        {"libm sincos (full)", circle_sincos_full,
+         DF2_PREC_FLOAT64, 1, 0, DF2_ISA_NONE, 1}
+    };
+
+    for (size_t i = 0; i < sizeof(builtins) / sizeof(builtins[0]); i++) {
+        registry_add(reg, &builtins[i], "builtin");
+    }
+}
+
 /*===========================================================================
  * Stability Analysis
  *===========================================================================*/
@@ -334,21 +501,30 @@ void analyze_stability(int r, int revolutions, double *drift) {
  * Main
  *===========================================================================*/
 
-int main(void) {
+int main(int argc, char **argv) {
     printf("================================================================\n");
     printf("  DF2 Circle Algorithm Benchmark\n");
-    printf("  All algorithms use 8-way symmetry\n");
+    printf("  8-way symmetric kernels plus full-circle direct evaluation\n");
     printf("================================================================\n\n");
     
-    /* Define algorithms */
-    Algorithm algorithms[] = {
-        {"DF2 Float", circle_df2_float_sym8},
-        {"DF2 Fixed (Q16.16)", circle_df2_fixed_sym8},
-        {"Coupled Float", circle_coupled_float_sym8},
-        {"Coupled Fixed (Q16.16)", circle_coupled_fixed_sym8},
-        {"Bresenham", circle_bresenham}
-    };
-    int num_algs = sizeof(algorithms) / sizeof(algorithms[0]);
+    /* Register kernels: built-ins, then DF2_KERNELS, then --kernel */
+    static Registry registry;
+    registry_add_builtins(&registry);
+    registry_load_env(&registry, "DF2_KERNELS");
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--kernel") == 0 && i + 1 < argc) {
+            registry_load(&registry, argv[++i]);
+        } else {
+            fprintf(stderr, "usage: %s [--kernel PATH.so]...\n", argv[0]);
+            return 1;
+        }
+    }
+    Algorithm *algorithms = registry.kernels;
+    int num_algs = registry.count;
+    
+    printf("KERNEL REGISTRY:\n");
+    registry_print(&registry);
+    printf("\n");
     
     /* Visual comparison */
     printf("VISUAL COMPARISON (radius=20):\n");
@@ -373,6 +549,7 @@ int main(void) {
     int radii[] = {10, 25, 50, 75, 100, 150, 200};
     int num_radii = sizeof(radii) / sizeof(radii[0]);
     int iterations = 50000;
+    registry_set_tune_radii(&registry, radii, num_radii);
     
     for (int ri = 0; ri < num_radii; ri++) {
         int r = radii[ri];
@@ -390,15 +567,21 @@ int main(void) {
             double time_us;
             int pixels;
             
-            run_benchmark(&algorithms[ai], fb, r, iterations, &time_us, &pixels);
-            
-            /* Skip if unstable (fixed-point at large radius) */
-            if (pixels < 10 && r > 50) {
+            /* Capabilities decide eligibility before anything runs */
+            if (!isa_supported(algorithms[ai].isa)) {
+                printf("%-24s %10s %8s %10s\n", 
+                       algorithms[ai].name, "NO ISA", "---", "---");
+                continue;
+            }
+            if (!kernel_supports_radius(&algorithms[ai], r)) {
                 printf("%-24s %10s %8s %10s\n", 
                        algorithms[ai].name, "UNSTABLE", "---", "---");
                 continue;
             }
             
+            run_benchmark(&algorithms[ai], fb, r, iterations, &time_us, &pixels);
+            registry_record(&registry, ai, ri, time_us);
+            
             double ns_per_pixel = (time_us * 1000.0) / pixels;
             
             printf("%-24s %10.2f %8d %10.2f\n",
@@ -415,6 +598,96 @@ int main(void) {
         fb_free(fb);
     }
     
+    /* Autotuned dispatch: what registry_select() returns per radius bucket */
+    printf("\n\nAUTOTUNED DISPATCH:\n");
+    printf("================================================================\n");
+    printf("%-16s %-24s %-24s\n", "Radius", "Any precision", "Q16.16 only");
+    printf("----------------------------------------------------------------\n");
+    for (int ri = 0; ri < num_radii; ri++) {
+        char range[32];
+        if (ri + 1 < num_radii) {
+            snprintf(range, sizeof(range), "%d..%d", radii[ri], radii[ri + 1] - 1);
+        } else {
+            snprintf(range, sizeof(range), "%d..", radii[ri]);
+        }
+        const Algorithm *any = registry_select(&registry, radii[ri], PREC_ANY, ~0u);
+        const Algorithm *q16 = registry_select(&registry, radii[ri], DF2_PREC_Q16_16, ~0u);
+        printf("%-16s %-24s %-24s\n", range, any ? any->name : "(none)",
+               q16 ? q16->name : "(none)");
+    }
+    
+    /* Dispatch smoke test: select, draw, and check the kernel drew a circle */
+    printf("\n\nDISPATCH SMOKE TEST:\n");
+    printf("================================================================\n");
+    printf("%-8s %-10s %-10s %-24s %8s %6s\n", "Radius", "Precision", "ISA",
+           "Selected", "Pixels", "Check");
+    printf("----------------------------------------------------------------\n");
+    
+    struct { int r; int precision; unsigned isa; } picks[] = {
+        {20, PREC_ANY, ~0u},
+        {120, PREC_ANY, ~0u},
+        {300, DF2_PREC_Q16_16, ~0u},
+        {300, PREC_ANY, DF2_ISA_NONE},
+        {1500, DF2_PREC_FLOAT64, DF2_ISA_NONE},
+        {60, DF2_PREC_FLOAT32, ~0u}
+    };
+    int smoke_failures = 0;
+    for (size_t i = 0; i < sizeof(picks) / sizeof(picks[0]); i++) {
+        int r = picks[i].r;
+        const Algorithm *alg = registry_select(&registry, r, picks[i].precision,
+                                               picks[i].isa);
+        const char *prec = picks[i].precision == PREC_ANY
+                         ? "any" : precision_name((Df2Precision)picks[i].precision);
+        const char *isa = picks[i].isa == ~0u ? "any" : "none";
+        if (!alg) {
+            printf("%-8d %-10s %-10s %-24s %8s %6s\n", r, prec, isa, "(none)",
+                   "---", "---");
+            continue;
+        }
+        
+        /* An 8-connected circle of radius r lights ~4 sqrt(2) r pixels */
+        fb = fb_create(2 * r + 3, 2 * r + 3);
+        alg->func(fb, 0, 0, r);
+        int pixels = fb_count_pixels(fb);
+        int ok = pixels >= 5 * r;
+        smoke_failures += !ok;
+        printf("%-8d %-10s %-10s %-24s %8d %6s\n", r, prec, isa, alg->name,
+               pixels, ok ? "ok" : "FAIL");
+        fb_free(fb);
+    }
+    
+    /* Direct evaluation accuracy: full-circle kernels vs per-point libm */
+    printf("\n\nFULL-CIRCLE ACCURACY (pixels differing from libm sincos):\n");
+    printf("================================================================\n");
+    
+    int acc_radii[] = {25, 100, 500, 2000};
+    int num_acc = sizeof(acc_radii) / sizeof(acc_radii[0]);
+    
+    printf("%-24s", "Algorithm");
+    for (int ri = 0; ri < num_acc; ri++) printf("   r=%-6d", acc_radii[ri]);
+    printf("\n----------------------------------------------------------------\n");
+    
+    for (int ai = 0; ai < num_algs; ai++) {
+        if (algorithms[ai].symmetry != 1 || !isa_supported(algorithms[ai].isa)) continue;
+        
+        printf("%-24s", algorithms[ai].name);
+        for (int ri = 0; ri < num_acc; ri++) {
+            int r = acc_radii[ri];
+            if (!kernel_supports_radius(&algorithms[ai], r)) {
+                printf(" %10s", "---");
+                continue;
+            }
+            Framebuffer *ref = fb_create(2 * r + 3, 2 * r + 3);
+            fb = fb_create(2 * r + 3, 2 * r + 3);
+            circle_sincos_full(ref, 0, 0, r);
+            algorithms[ai].func(fb, 0, 0, r);
+            printf(" %10d", fb_diff_pixels(fb, ref));
+            fb_free(ref);
+            fb_free(fb);
+        }
+        printf("\n");
+    }
+    
     /* Stability analysis */
     printf("\n\nSTABILITY ANALYSIS (100 revolutions, float64):\n");
     printf("================================================================\n");
@@ -449,8 +722,8 @@ int main(void) {
     };
     
     for (int i = 0; i < 6; i++) {
-        double r_crit = 0.47 * pow(2.0, formats[i].bits / 2.0);
-        printf("%-20s %8d %12.0f\n", formats[i].name, formats[i].bits, r_crit);
+        printf("%-20s %8d %12d\n", formats[i].name, formats[i].bits,
+               critical_radius(formats[i].bits));
     }
     
     printf("\n\nCONCLUSION:\n");
@@ -460,5 +733,6 @@ int main(void) {
     printf("at larger radii due to the coefficient approaching 2.0.\n");
     printf("Floating-point implementations remain stable for all practical radii.\n");
     
-    return 0;
+    registry_close(&registry);
+    return smoke_failures ? 1 : 0;
 }
@@ -0,0 +1,129 @@
+/*
+ * DF2 Circle Kernel Interface
+ *
+ * Shared by df2_benchmark and by kernels loaded from shared objects.  A
+ * kernel is an Algorithm: a draw function plus the capabilities that the
+ * benchmark and dispatcher use to decide where it may run.
+ *
+ * Writing a loadable kernel:
+ *
+ *   #include "df2_kernel.h"
+ *
+ *   static int my_circle(Framebuffer *fb, int cx, int cy, int r) { ... }
+ *
+ *   static const Algorithm kernels[] = {
+ *       {"My Kernel", my_circle, DF2_PREC_FLOAT32, 1, 1000, DF2_ISA_AVX2, 8},
+ *   };
+ *
+ *   DF2_EXPORT_KERNELS(kernels)
+ *
+ * Build with -shared -fPIC and pass the .so to df2_benchmark with
+ * --kernel, or list it in the DF2_KERNELS environment variable.
+ */
+
+#ifndef DF2_KERNEL_H
+#define DF2_KERNEL_H
+
+#include <stdint.h>
+
+/*===========================================================================
+ * Fixed-Point Arithmetic (Q16.16)
+ *===========================================================================*/
+
+#define FP_BITS 16
+#define FP_ONE (1 << FP_BITS)
+#define FP_HALF (1 << (FP_BITS - 1))
+
+typedef int32_t fixed_t;
+
+static inline fixed_t to_fixed(double d) {
+    return (fixed_t)(d * FP_ONE + (d >= 0 ? 0.5 : -0.5));
+}
+
+static inline int fixed_to_int(fixed_t f) {
+    return (f + FP_HALF) >> FP_BITS;
+}
+
+static inline fixed_t fp_mul(fixed_t a, fixed_t b) {
+    return (fixed_t)(((int64_t)a * b) >> FP_BITS);
+}
+
+/*===========================================================================
+ * Framebuffer
+ *===========================================================================*/
+
+typedef struct {
+    int width, height;
+    uint8_t *pixels;
+} Framebuffer;
+
+static inline void fb_plot(Framebuffer *fb, int x, int y) {
+    x += fb->width / 2;
+    y += fb->height / 2;
+    if (x >= 0 && x < fb->width && y >= 0 && y < fb->height) {
+        fb->pixels[y * fb->width + x] = 1;
+    }
+}
+
+/* 8-way symmetric plot */
+static inline void fb_plot8(Framebuffer *fb, int cx, int cy, int x, int y) {
+    fb_plot(fb, cx + x, cy + y);
+    fb_plot(fb, cx - x, cy + y);
+    fb_plot(fb, cx + x, cy - y);
+    fb_plot(fb, cx - x, cy - y);
+    fb_plot(fb, cx + y, cy + x);
+    fb_plot(fb, cx - y, cy + x);
+    fb_plot(fb, cx + y, cy - x);
+    fb_plot(fb, cx - y, cy - x);
+}
+
+/*===========================================================================
+ * Kernel Capabilities
+ *===========================================================================*/
+
+typedef enum {
+    DF2_PREC_INT,           /* integer only (e.g. Bresenham) */
+    DF2_PREC_Q16_16,
+    DF2_PREC_Q1_31,
+    DF2_PREC_FLOAT32,
+    DF2_PREC_FLOAT64
+} Df2Precision;
+
+/* Instruction set requirements, OR'd together */
+#define DF2_ISA_NONE    0u
+#define DF2_ISA_SSE2    (1u << 0)
+#define DF2_ISA_SSE41   (1u << 1)
+#define DF2_ISA_AVX2    (1u << 2)
+#define DF2_ISA_FMA     (1u << 3)
+#define DF2_ISA_AVX512F (1u << 4)
+
+typedef struct {
+    const char *name;
+    int (*func)(Framebuffer*, int, int, int);
+    Df2Precision precision;
+    int min_radius;         /* smallest radius drawn correctly */
+    int max_radius;         /* largest stable radius; 0 = unbounded */
+    unsigned isa;           /* DF2_ISA_* flags required to run */
+    int symmetry;           /* 8 = octant mirrored, 1 = full circle walked */
+} Algorithm;
+
+/*===========================================================================
+ * Loadable Kernels
+ *
+ * A shared object exports DF2_KERNEL_ENTRY.  It is called with the host's
+ * ABI version and returns its kernel table (or NULL to decline).
+ *===========================================================================*/
+
+#define DF2_KERNEL_ABI_VERSION 1
+#define DF2_KERNEL_ENTRY "df2_kernels"
+
+typedef const Algorithm *(*Df2KernelEntry)(int abi_version, int *count);
+
+#define DF2_EXPORT_KERNELS(table)                                           \
+    const Algorithm *df2_kernels(int abi_version, int *count) {             \
+        if (abi_version != DF2_KERNEL_ABI_VERSION) return 0;                \
+        *count = (int)(sizeof(table) / sizeof((table)[0]));                 \
+        return table;                                                       \
+    }
+
+#endif /* DF2_KERNEL_H */
@@ -0,0 +1,59 @@
+/*
+ * Example loadable DF2 kernel
+ *
+ * A single-precision DF2 octant walk, packaged as a shared object to show
+ * how experimental kernels plug into df2_benchmark without recompiling it.
+ *
+ * Compile: gcc -O3 -shared -fPIC -o df2_kernel_example.so df2_kernel_example.c -lm
+ * Run:     ./df2_benchmark --kernel ./df2_kernel_example.so
+ */
+
+#include <math.h>
+
+#include "df2_kernel.h"
+
+/*===========================================================================
+ * DF2 Circle - Float32 with 8-way Symmetry
+ *===========================================================================*/
+
+static int circle_df2_float32_sym8(Framebuffer *fb, int cx, int cy, int r) {
+    if (r <= 0) return 0;
+    
+    float omega = 1.0f / (1.5f * r);
+    float coeff = 2.0f * cosf(omega);
+    float scale = -1.0f / omega;
+    
+    float w0 = r * cosf(omega);
+    float w1 = (float)r;
+    
+    int pixels = 0;
+    
+    while (1) {
+        int x = (int)lrintf(w1);
+        int y = (int)lrintf((w1 - w0) * scale);
+        
+        if (y > x) break;
+        
+        fb_plot8(fb, cx, cy, x, y);
+        pixels += 8;
+        
+        float w2 = coeff * w1 - w0;
+        w0 = w1;
+        w1 = w2;
+    }
+    
+    return pixels;
+}
+
+/*===========================================================================
+ * Kernel Table
+ *
+ * Float32 has 23 fractional mantissa bits: r_crit ~ 0.47 * 2^11.5 ~ 1361.
+ *===========================================================================*/
+
+static const Algorithm kernels[] = {
+    {"DF2 Float32 (plugin)", circle_df2_float32_sym8,
+     DF2_PREC_FLOAT32, 1, 1361, DF2_ISA_NONE, 8}
+};
+
+DF2_EXPORT_KERNELS(kernels)
@@ -0,0 +1,43 @@
+/*
+ * Quarter-Wave Sine Table
+ *
+ * Shared by the Sine LUT kernel in df2_benchmark and its split setup/draw
+ * version in startup_latency.  The table is filled by sin_lut_init(),
+ * which the including program calls once before any lookup.
+ */
+
+#ifndef DF2_LUT_H
+#define DF2_LUT_H
+
+#include <stdint.h>
+#include <math.h>
+
+#define LUT_BITS 10
+#define LUT_SIZE (1 << LUT_BITS)
+#define LUT_FRAC_BITS (30 - LUT_BITS)
+
+/* Interpolation error ~ (pi/2 / LUT_SIZE)^2 / 8 = 2.9e-7: half a pixel at 1.7M.
+ * Truncating the phase to 32 bits adds at most 2*pi*r / 2^32 px. */
+#define LUT_MAX_RADIUS 1000000
+
+static double sin_lut[LUT_SIZE + 2];
+
+static void sin_lut_init(void) {
+    for (int i = 0; i <= LUT_SIZE + 1; i++) {
+        sin_lut[i] = sin(i * (M_PI / 2) / LUT_SIZE);
+    }
+}
+
+static inline double lut_sin(uint32_t phase) {
+    uint32_t q = phase >> 30;
+    uint32_t p = phase & 0x3FFFFFFF;
+    if (q & 1) p = 0x40000000 - p;  /* mirror within the quadrant */
+    
+    uint32_t i = p >> LUT_FRAC_BITS;
+    double f = (p & ((1u << LUT_FRAC_BITS) - 1)) * (1.0 / (1u << LUT_FRAC_BITS));
+    double s = sin_lut[i] + (sin_lut[i + 1] - sin_lut[i]) * f;
+    
+    return (q & 2) ? -s : s;
+}
+
+#endif /* DF2_LUT_H */
@@ -0,0 +1,205 @@
+/*
+ * DF2 Kernel Registry
+ *
+ * Holds kernels with their capabilities, loads more from shared objects
+ * (see df2_kernel.h), and dispatches by radius, precision and ISA.  Used
+ * by df2_benchmark, which registers its built-ins and autotunes, and by
+ * startup_latency, which times plugin loading from a cold process.
+ *
+ * Programs including this header link with -ldl.
+ */
+
+#ifndef DF2_REGISTRY_H
+#define DF2_REGISTRY_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <dlfcn.h>
+
+#include "df2_kernel.h"
+
+#define MAX_KERNELS 64
+#define MAX_PLUGINS 16
+#define MAX_TUNE_RADII 16
+
+typedef struct {
+    Algorithm kernels[MAX_KERNELS];
+    const char *source[MAX_KERNELS];    /* "builtin" or the .so path */
+    int count;
+    void *handles[MAX_PLUGINS];
+    int num_handles;
+    /* Autotuning: bucket b covers tune_radii[b] .. tune_radii[b+1] - 1 */
+    int tune_radii[MAX_TUNE_RADII];
+    int num_tune;
+    double tune_us[MAX_KERNELS][MAX_TUNE_RADII];    /* 0 = not measured */
+} Registry;
+
+static inline void registry_add(Registry *reg, const Algorithm *alg, const char *source) {
+    if (reg->count == MAX_KERNELS) {
+        fprintf(stderr, "registry full, dropping kernel '%s'\n", alg->name);
+        return;
+    }
+    reg->kernels[reg->count] = *alg;
+    reg->source[reg->count] = source;
+    reg->count++;
+}
+
+/* Returns the number of kernels added, or -1 if the object was rejected */
+static inline int registry_load(Registry *reg, const char *path) {
+    if (reg->num_handles == MAX_PLUGINS) {
+        fprintf(stderr, "%s: too many kernel plugins\n", path);
+        return -1;
+    }
+
+    void *handle = dlopen(path, RTLD_NOW | RTLD_LOCAL);
+    if (!handle) {
+        fprintf(stderr, "%s\n", dlerror());
+        return -1;
+    }
+
+    Df2KernelEntry entry = (Df2KernelEntry)dlsym(handle, DF2_KERNEL_ENTRY);
+    int count = 0;
+    const Algorithm *table = entry ? entry(DF2_KERNEL_ABI_VERSION, &count) : NULL;
+    if (!table) {
+        fprintf(stderr, "%s: no compatible %s() (host ABI %d)\n",
+                path, DF2_KERNEL_ENTRY, DF2_KERNEL_ABI_VERSION);
+        dlclose(handle);
+        return -1;
+    }
+
+    reg->handles[reg->num_handles++] = handle;
+    for (int i = 0; i < count; i++) registry_add(reg, &table[i], path);
+    return count;
+}
+
+static inline void registry_load_env(Registry *reg, const char *var) {
+    const char *list = getenv(var);
+    if (!list || !*list) return;
+
+    char *copy = strdup(list);
+    for (char *path = strtok(copy, ":"); path; path = strtok(NULL, ":")) {
+        /* Paths must outlive the registry; keep a private copy of each */
+        registry_load(reg, strdup(path));
+    }
+    free(copy);
+}
+
+static inline void registry_close(Registry *reg) {
+    for (int i = 0; i < reg->num_handles; i++) dlclose(reg->handles[i]);
+    reg->num_handles = 0;
+    reg->count = 0;
+}
+
+static inline int isa_supported(unsigned isa) {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_cpu_init();
+    if ((isa & DF2_ISA_SSE2) && !__builtin_cpu_supports("sse2")) return 0;
+    if ((isa & DF2_ISA_SSE41) && !__builtin_cpu_supports("sse4.1")) return 0;
+    if ((isa & DF2_ISA_AVX2) && !__builtin_cpu_supports("avx2")) return 0;
+    if ((isa & DF2_ISA_FMA) && !__builtin_cpu_supports("fma")) return 0;
+    if ((isa & DF2_ISA_AVX512F) && !__builtin_cpu_supports("avx512f")) return 0;
+    return 1;
+#else
+    return isa == DF2_ISA_NONE;
+#endif
+}
+
+static inline int kernel_supports_radius(const Algorithm *alg, int r) {
+    return r >= alg->min_radius && (alg->max_radius == 0 || r <= alg->max_radius);
+}
+
+/* Radii must ascend; clears any earlier timings */
+static inline void registry_set_tune_radii(Registry *reg, const int *radii, int n) {
+    if (n > MAX_TUNE_RADII) n = MAX_TUNE_RADII;
+    memcpy(reg->tune_radii, radii, n * sizeof(int));
+    reg->num_tune = n;
+    memset(reg->tune_us, 0, sizeof(reg->tune_us));
+}
+
+static inline void registry_record(Registry *reg, int kernel, int bucket, double time_us) {
+    if (bucket >= 0 && bucket < reg->num_tune) reg->tune_us[kernel][bucket] = time_us;
+}
+
+static inline int registry_bucket(const Registry *reg, int r) {
+    int b = 0;
+    while (b + 1 < reg->num_tune && reg->tune_radii[b + 1] <= r) b++;
+    return b;
+}
+
+#define PREC_ANY (-1)
+
+/*
+ * Dispatch: the fastest measured kernel in r's bucket among those that are
+ * runnable here, stable at r, need no ISA outside 'isa_allowed' and match
+ * 'precision' (or PREC_ANY).  Eligible but unmeasured kernels fall back to
+ * registration order.  Returns NULL when nothing is eligible.
+ */
+static inline const Algorithm *registry_select(const Registry *reg, int r, int precision,
+                                 unsigned isa_allowed) {
+    int bucket = reg->num_tune ? registry_bucket(reg, r) : -1;
+    const Algorithm *best = NULL, *first = NULL;
+    double best_us = 0;
+
+    for (int i = 0; i < reg->count; i++) {
+        const Algorithm *alg = &reg->kernels[i];
+        if ((alg->isa & ~isa_allowed) || !isa_supported(alg->isa)) continue;
+        if (!kernel_supports_radius(alg, r)) continue;
+        if (precision != PREC_ANY && (int)alg->precision != precision) continue;
+
+        if (!first) first = alg;
+        double us = bucket >= 0 ? reg->tune_us[i][bucket] : 0;
+        if (us > 0 && (!best || us < best_us)) {
+            best = alg;
+            best_us = us;
+        }
+    }
+    return best ? best : first;
+}
+
+static inline const char *precision_name(Df2Precision p) {
+    switch (p) {
+    case DF2_PREC_INT:     return "int";
+    case DF2_PREC_Q16_16:  return "Q16.16";
+    case DF2_PREC_Q1_31:   return "Q1.31";
+    case DF2_PREC_FLOAT32: return "float32";
+    case DF2_PREC_FLOAT64: return "float64";
+    }
+    return "?";
+}
+
+static inline void isa_name(unsigned isa, char *buf, size_t len) {
+    static const struct { unsigned bit; const char *name; } names[] = {
+        {DF2_ISA_SSE2, "sse2"}, {DF2_ISA_SSE41, "sse4.1"},
+        {DF2_ISA_AVX2, "avx2"}, {DF2_ISA_FMA, "fma"},
+        {DF2_ISA_AVX512F, "avx512f"}
+    };
+
+    snprintf(buf, len, "%s", isa ? "" : "-");
+    for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); i++) {
+        if (!(isa & names[i].bit)) continue;
+        size_t used = strlen(buf);
+        snprintf(buf + used, len - used, "%s%s", used ? "+" : "", names[i].name);
+    }
+}
+
+static inline void registry_print(const Registry *reg) {
+    printf("%-24s %-8s %14s %-10s %4s  %s\n",
+           "Kernel", "Prec", "Radius", "ISA", "Sym", "Source");
+    printf("----------------------------------------------------------------\n");
+    for (int i = 0; i < reg->count; i++) {
+        const Algorithm *alg = &reg->kernels[i];
+        char range[32], isa[48];
+        if (alg->max_radius) {
+            snprintf(range, sizeof(range), "%d..%d", alg->min_radius, alg->max_radius);
+        } else {
+            snprintf(range, sizeof(range), "%d..", alg->min_radius);
+        }
+        isa_name(alg->isa, isa, sizeof(isa));
+        printf("%-24s %-8s %14s %-10s %3dx  %s%s\n", alg->name,
+               precision_name(alg->precision), range, isa, alg->symmetry,
+               reg->source[i], isa_supported(alg->isa) ? "" : " (not runnable)");
+    }
+}
+
+#endif /* DF2_REGISTRY_H */
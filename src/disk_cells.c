@@ -0,0 +1,713 @@
+/*
+ * DF2 Disk Coverage as Grid-Cell ID Sets
+ *
+ * A spatial index wants the cells a disk covers, not a bitmap.  The DF2
+ * filled-span walker already produces one [x0, x1] span per row, so the
+ * covered cells can be emitted directly as sorted 64-bit cell IDs:
+ *
+ *   Row-major:  id = row << 32 | col      (each span is one ID run)
+ *   Morton:     id = interleave(row, col)  (quadtree descent, Z order)
+ *
+ * Sets are stored as sorted, disjoint, inclusive ID runs, which makes union
+ * and intersection linear merges.  A pthreads batch mode exports many
+ * disks at once.  Compared against rasterizing into a Framebuffer and
+ * scanning it.
+ *
+ * Compile: gcc -O3 -pthread -o disk_cells disk_cells.c -lm
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <stdint.h>
+#include <pthread.h>
+
+/*===========================================================================
+ * Framebuffer (raster baseline only)
+ *===========================================================================*/
+
+typedef struct {
+    int width, height;
+    uint8_t *pixels;
+} Framebuffer;
+
+Framebuffer* fb_create(int w, int h) {
+    Framebuffer *fb = malloc(sizeof(Framebuffer));
+    fb->width = w;
+    fb->height = h;
+    fb->pixels = calloc(w * h, 1);
+    return fb;
+}
+
+void fb_clear(Framebuffer *fb) {
+    memset(fb->pixels, 0, fb->width * fb->height);
+}
+
+void fb_free(Framebuffer *fb) {
+    free(fb->pixels);
+    free(fb);
+}
+
+/*===========================================================================
+ * Cell IDs
+ *===========================================================================*/
+
+typedef enum { ORDER_ROW_MAJOR, ORDER_MORTON } CellOrder;
+
+static inline uint64_t cell_id_row_major(uint32_t col, uint32_t row) {
+    return ((uint64_t)row << 32) | col;
+}
+
+/* Spread the 32 bits of v over the even bits of a 64-bit word */
+static inline uint64_t part1by1(uint32_t v) {
+    uint64_t x = v;
+    x = (x | (x << 16)) & 0x0000FFFF0000FFFFULL;
+    x = (x | (x << 8))  & 0x00FF00FF00FF00FFULL;
+    x = (x | (x << 4))  & 0x0F0F0F0F0F0F0F0FULL;
+    x = (x | (x << 2))  & 0x3333333333333333ULL;
+    x = (x | (x << 1))  & 0x5555555555555555ULL;
+    return x;
+}
+
+static inline uint64_t cell_id_morton(uint32_t col, uint32_t row) {
+    return part1by1(col) | (part1by1(row) << 1);
+}
+
+/*===========================================================================
+ * Cell Sets (sorted, disjoint, inclusive ID runs)
+ *
+ * Runs are [lo, hi] rather than [lo, hi): the whole 32 x 32-bit grid is
+ * addressable, so a run may end at ID 2^64 - 1, where a half-open end
+ * would wrap to 0.
+ *===========================================================================*/
+
+typedef struct {
+    uint64_t lo, hi;    /* [lo, hi] */
+} CellRun;
+
+typedef struct {
+    CellRun *runs;
+    size_t count, cap;
+} CellSet;
+
+void cellset_init(CellSet *s) {
+    s->runs = NULL;
+    s->count = s->cap = 0;
+}
+
+void cellset_free(CellSet *s) {
+    free(s->runs);
+    cellset_init(s);
+}
+
+/* Append a run; runs must arrive sorted by lo.  Overlapping or adjacent
+ * runs are coalesced (lo - hi == 1 cannot wrap, since lo > hi there). */
+static inline void cellset_push(CellSet *s, uint64_t lo, uint64_t hi) {
+    if (s->count && (lo <= s->runs[s->count - 1].hi ||
+                     lo - s->runs[s->count - 1].hi == 1)) {
+        if (hi > s->runs[s->count - 1].hi) s->runs[s->count - 1].hi = hi;
+        return;
+    }
+    if (s->count == s->cap) {
+        s->cap = s->cap ? s->cap * 2 : 64;
+        s->runs = realloc(s->runs, s->cap * sizeof(CellRun));
+    }
+    s->runs[s->count].lo = lo;
+    s->runs[s->count].hi = hi;
+    s->count++;
+}
+
+/* Wraps to 0 only for the full 2^64-cell grid */
+uint64_t cellset_cells(const CellSet *s) {
+    uint64_t n = 0;
+    for (size_t i = 0; i < s->count; i++) n += s->runs[i].hi - s->runs[i].lo + 1;
+    return n;
+}
+
+int cellset_equal(const CellSet *a, const CellSet *b) {
+    return a->count == b->count &&
+           memcmp(a->runs, b->runs, a->count * sizeof(CellRun)) == 0;
+}
+
+/* Expand to a plain sorted ID array; returns the number written */
+size_t cellset_expand(const CellSet *s, uint64_t *ids) {
+    size_t n = 0;
+    for (size_t i = 0; i < s->count; i++) {
+        uint64_t id = s->runs[i].lo;
+        do {
+            ids[n++] = id;
+        } while (id++ != s->runs[i].hi);
+    }
+    return n;
+}
+
+void cellset_union(const CellSet *a, const CellSet *b, CellSet *out) {
+    size_t i = 0, j = 0;
+    out->count = 0;
+    while (i < a->count || j < b->count) {
+        const CellRun *r;
+        if (j == b->count || (i < a->count && a->runs[i].lo <= b->runs[j].lo)) {
+            r = &a->runs[i++];
+        } else {
+            r = &b->runs[j++];
+        }
+        cellset_push(out, r->lo, r->hi);
+    }
+}
+
+void cellset_intersect(const CellSet *a, const CellSet *b, CellSet *out) {
+    size_t i = 0, j = 0;
+    out->count = 0;
+    while (i < a->count && j < b->count) {
+        uint64_t lo = a->runs[i].lo > b->runs[j].lo ? a->runs[i].lo : b->runs[j].lo;
+        uint64_t hi = a->runs[i].hi < b->runs[j].hi ? a->runs[i].hi : b->runs[j].hi;
+        if (lo <= hi) cellset_push(out, lo, hi);
+        if (a->runs[i].hi < b->runs[j].hi) i++;
+        else j++;
+    }
+}
+
+/*===========================================================================
+ * Scratch Space (one per thread)
+ *===========================================================================*/
+
+typedef struct {
+    double *h;              /* DF2 sub-pixel half-widths */
+    int64_t *w;             /* covered half-width per row offset */
+    int h_cap;
+    uint64_t *ids, *tmp;    /* raster baseline: Morton IDs and sort buffer */
+    size_t id_cap;
+} CellScratch;
+
+void scratch_init(CellScratch *s) {
+    memset(s, 0, sizeof(*s));
+}
+
+void scratch_free(CellScratch *s) {
+    free(s->h);
+    free(s->w);
+    free(s->ids);
+    free(s->tmp);
+    scratch_init(s);
+}
+
+static void scratch_reserve(CellScratch *s, int rows, size_t ids) {
+    if (rows + 1 > s->h_cap) {
+        s->h_cap = rows + 1;
+        s->h = realloc(s->h, s->h_cap * sizeof(double));
+        s->w = realloc(s->w, s->h_cap * sizeof(int64_t));
+    }
+    if (ids > s->id_cap) {
+        s->id_cap = ids;
+        s->ids = realloc(s->ids, ids * sizeof(uint64_t));
+        s->tmp = realloc(s->tmp, ids * sizeof(uint64_t));
+    }
+}
+
+/*===========================================================================
+ * DF2 Filled-Span Walker
+ *
+ * One octant walk gives the sub-pixel half-width h[k] = sqrt(r^2 - k^2) at
+ * every integer row k (x crossings fill the upper rows by symmetry).  The
+ * covered half-width of row k is floor(h[k]), nudged by an exact integer
+ * test so that cell membership is exactly i^2 + k^2 <= r^2.
+ *===========================================================================*/
+
+static void df2_half_widths(double r, double *h, int rows) {
+    double omega = 1.0 / (1.5 * r);
+    if (omega > M_PI / 8) omega = M_PI / 8;
+
+    double c = cos(omega);
+    double coeff = 2.0 * c;
+    double inv_s = 1.0 / sin(omega);
+
+    double w0 = r * c;
+    double w1 = r;
+
+    double xp = r, yp = 0.0;
+    int ky = 1;
+    int kx = rows - 1;
+
+    h[0] = r;
+    h[rows] = 0.0;
+
+    for (int n = 0; ky <= kx && n < 4 * rows + 16; n++) {
+        double w2 = coeff * w1 - w0;
+        w0 = w1;
+        w1 = w2;
+
+        double x = w1;
+        double y = (w0 - w1 * c) * inv_s;
+
+        while (ky <= kx && ky <= y) {
+            h[ky] = xp + (x - xp) * (ky - yp) / (y - yp);
+            ky++;
+        }
+        while (kx >= ky && kx >= x) {
+            h[kx] = yp + (y - yp) * (xp - kx) / (xp - x);
+            kx--;
+        }
+
+        xp = x;
+        yp = y;
+    }
+}
+
+static inline int64_t covered_half_width(const double *h, int k, double r2) {
+    int64_t w = (int64_t)h[k];
+    int64_t k2 = (int64_t)k * k;
+    while ((double)((w + 1) * (w + 1) + k2) <= r2) w++;
+    while (w >= 0 && (double)(w * w + k2) > r2) w--;
+    return w;
+}
+
+typedef struct {
+    uint32_t cx, cy;    /* centre cell */
+    double r;           /* radius in cells */
+} DiskQuery;
+
+/* Clip a row span to the 32-bit grid; returns 0 if nothing remains */
+static inline int clip_span(const DiskQuery *q, int k, int64_t w,
+                            uint32_t *row, uint32_t *c0, uint32_t *c1) {
+    int64_t y = (int64_t)q->cy + k;
+    int64_t x0 = (int64_t)q->cx - w, x1 = (int64_t)q->cx + w;
+    if (w < 0 || y < 0 || y > UINT32_MAX) return 0;
+    if (x0 < 0) x0 = 0;
+    if (x1 > UINT32_MAX) x1 = UINT32_MAX;
+    *row = (uint32_t)y;
+    *c0 = (uint32_t)x0;
+    *c1 = (uint32_t)x1;
+    return 1;
+}
+
+/* LSD radix sort, skipping bytes that are constant across the input */
+static void sort_ids(uint64_t *ids, uint64_t *tmp, size_t n) {
+    if (n < 2) return;
+
+    /* A byte is constant only if no ID differs from the first in it */
+    uint64_t diff = 0;
+    for (size_t i = 1; i < n; i++) diff |= ids[i] ^ ids[0];
+
+    uint64_t *src = ids, *dst = tmp;
+    for (int shift = 0; shift < 64; shift += 8) {
+        if (!((diff >> shift) & 0xFF)) continue;
+
+        size_t count[257] = {0};
+        for (size_t i = 0; i < n; i++) count[((src[i] >> shift) & 0xFF) + 1]++;
+        for (int d = 0; d < 256; d++) count[d + 1] += count[d];
+        for (size_t i = 0; i < n; i++) dst[count[(src[i] >> shift) & 0xFF]++] = src[i];
+
+        uint64_t *t = src;
+        src = dst;
+        dst = t;
+    }
+
+    if (src != ids) memcpy(ids, src, n * sizeof(uint64_t));
+}
+
+static void runs_from_sorted(const uint64_t *ids, size_t n, CellSet *out) {
+    for (size_t i = 0; i < n; ) {
+        size_t j = i + 1;
+        while (j < n && ids[j] == ids[j - 1] + 1) j++;
+        cellset_push(out, ids[i], ids[j - 1]);
+        i = j;
+    }
+}
+
+/* Fill scr->w[0..top] for the query; returns top = floor(r) */
+static int df2_row_widths(const DiskQuery *q, CellScratch *scr) {
+    int rows = (int)ceil(q->r);
+    int top = (int)q->r;
+    double r2 = q->r * q->r;
+
+    scratch_reserve(scr, rows, 0);
+    df2_half_widths(q->r, scr->h, rows);
+    for (int k = 0; k <= top; k++) {
+        scr->w[k] = covered_half_width(scr->h, k, r2);
+    }
+    return top;
+}
+
+/*
+ * Morton order without sorting: descend the aligned quadtree over the
+ * disk's bounding box, visiting children in Z order.  The row widths make
+ * both block tests O(1), because |row - cy| is largest at a block's end
+ * rows and smallest at the row nearest the centre:
+ *   empty  if the nearest row's span misses the block's columns
+ *   full   if both end rows' spans cover them (emit one run of 4^level)
+ */
+typedef struct {
+    int64_t cx, cy;
+    int top;
+    const int64_t *w;
+} MortonWalk;
+
+static inline int64_t row_width(const MortonWalk *m, int64_t y) {
+    int64_t d = y < m->cy ? m->cy - y : y - m->cy;
+    return d > m->top ? -1 : m->w[d];
+}
+
+static void morton_descend(const MortonWalk *m, int64_t bx, int64_t by,
+                           int level, CellSet *out) {
+    int64_t size = (int64_t)1 << level;
+    int64_t x0 = bx, x1 = bx + size - 1;
+    int64_t y0 = by, y1 = by + size - 1;
+
+    int64_t yn = m->cy < y0 ? y0 : (m->cy > y1 ? y1 : m->cy);
+    int64_t wn = row_width(m, yn);
+    if (wn < 0 || m->cx + wn < x0 || m->cx - wn > x1) return;
+
+    int64_t w0 = row_width(m, y0), w1 = row_width(m, y1);
+    int64_t wf = w0 < w1 ? w0 : w1;
+    if (wf >= 0 && m->cx - wf <= x0 && m->cx + wf >= x1) {
+        uint64_t id = cell_id_morton((uint32_t)bx, (uint32_t)by);
+        cellset_push(out, id, level ? id | (~0ULL >> (64 - 2 * level)) : id);
+        return;
+    }
+
+    int64_t half = size >> 1;
+    morton_descend(m, bx, by, level - 1, out);
+    morton_descend(m, bx + half, by, level - 1, out);
+    morton_descend(m, bx, by + half, level - 1, out);
+    morton_descend(m, bx + half, by + half, level - 1, out);
+}
+
+/*===========================================================================
+ * ALGORITHM 1: DF2 Span Walker -> Cell Set
+ *===========================================================================*/
+
+void disk_cells_df2(const DiskQuery *q, CellOrder order, CellSet *out,
+                    CellScratch *scr) {
+    out->count = 0;
+    if (q->r < 0) return;
+
+    int top = df2_row_widths(q, scr);
+
+    if (order == ORDER_ROW_MAJOR) {
+        /* Rows ascend and each span is contiguous: one run per row */
+        for (int k = -top; k <= top; k++) {
+            uint32_t row, c0, c1;
+            if (!clip_span(q, k, scr->w[k < 0 ? -k : k], &row, &c0, &c1)) continue;
+            cellset_push(out, cell_id_row_major(c0, row),
+                         cell_id_row_major(c1, row));
+        }
+        return;
+    }
+
+    /* Morton: smallest aligned block holding the clipped bounding box */
+    int64_t bx0 = (int64_t)q->cx - top, bx1 = (int64_t)q->cx + top;
+    int64_t by0 = (int64_t)q->cy - top, by1 = (int64_t)q->cy + top;
+    if (bx0 < 0) bx0 = 0;
+    if (by0 < 0) by0 = 0;
+    if (bx1 > UINT32_MAX) bx1 = UINT32_MAX;
+    if (by1 > UINT32_MAX) by1 = UINT32_MAX;
+
+    uint64_t diff = (uint64_t)((bx0 ^ bx1) | (by0 ^ by1));
+    int level = 0;
+    while (diff >> level) level++;
+
+    int64_t mask = ~(((int64_t)1 << level) - 1);
+    MortonWalk m = { q->cx, q->cy, top, scr->w };
+    morton_descend(&m, bx0 & mask, by0 & mask, level, out);
+}
+
+/*===========================================================================
+ * ALGORITHM 2: Rasterize into a Framebuffer, then Scan (baseline)
+ *
+ * The framebuffer is a window of (2R+1)^2 pixels around the centre cell,
+ * filled by testing i^2 + k^2 <= r^2 per pixel.  It shares nothing with
+ * the DF2 walker, so matching sets check the walker's membership.
+ *===========================================================================*/
+
+void disk_cells_raster(const DiskQuery *q, CellOrder order, CellSet *out,
+                       CellScratch *scr, Framebuffer *fb) {
+    out->count = 0;
+    if (q->r < 0) return;
+
+    int top = (int)q->r;
+    double r2 = q->r * q->r;
+    scratch_reserve(scr, top, (size_t)fb->width * fb->height);
+
+    fb_clear(fb);
+    for (int k = -top; k <= top; k++) {
+        uint8_t *p = fb->pixels + (k + top) * fb->width + top;
+        for (int i = -top; i <= top; i++) {
+            p[i] = (double)((int64_t)i * i + (int64_t)k * k) <= r2;
+        }
+    }
+
+    size_t n = 0;
+    for (int py = 0; py < fb->height; py++) {
+        int64_t y = (int64_t)q->cy + py - top;
+        if (y < 0 || y > UINT32_MAX) continue;
+        const uint8_t *p = fb->pixels + py * fb->width;
+
+        for (int px = 0; px < fb->width; px++) {
+            if (!p[px]) continue;
+            int64_t x = (int64_t)q->cx + px - top;
+            if (x < 0 || x > UINT32_MAX) continue;
+
+            if (order == ORDER_ROW_MAJOR) {
+                uint64_t id = cell_id_row_major((uint32_t)x, (uint32_t)y);
+                cellset_push(out, id, id);
+            } else {
+                scr->ids[n++] = cell_id_morton((uint32_t)x, (uint32_t)y);
+            }
+        }
+    }
+
+    if (order == ORDER_MORTON) {
+        sort_ids(scr->ids, scr->tmp, n);
+        runs_from_sorted(scr->ids, n, out);
+    }
+}
+
+/*===========================================================================
+ * Batch Mode (pthreads)
+ *
+ * Workers pull blocks of queries from a shared counter, each with its own
+ * scratch space; out[i] receives the set for queries[i].
+ *===========================================================================*/
+
+#define BATCH_BLOCK 64
+
+typedef struct {
+    const DiskQuery *queries;
+    CellSet *out;
+    int count;
+    CellOrder order;
+    int next;
+    pthread_mutex_t lock;
+} BatchJob;
+
+static void *batch_worker(void *arg) {
+    BatchJob *job = arg;
+    CellScratch scr;
+    scratch_init(&scr);
+
+    for (;;) {
+        pthread_mutex_lock(&job->lock);
+        int start = job->next;
+        job->next += BATCH_BLOCK;
+        pthread_mutex_unlock(&job->lock);
+
+        if (start >= job->count) break;
+        int end = start + BATCH_BLOCK < job->count ? start + BATCH_BLOCK : job->count;
+        for (int i = start; i < end; i++) {
+            disk_cells_df2(&job->queries[i], job->order, &job->out[i], &scr);
+        }
+    }
+
+    scratch_free(&scr);
+    return NULL;
+}
+
+void disk_cells_batch(const DiskQuery *queries, int count, CellOrder order,
+                      CellSet *out, int threads) {
+    BatchJob job = { queries, out, count, order, 0, PTHREAD_MUTEX_INITIALIZER };
+
+    if (threads < 1) threads = 1;
+    pthread_t *tid = malloc(threads * sizeof(pthread_t));
+    for (int t = 1; t < threads; t++) pthread_create(&tid[t], NULL, batch_worker, &job);
+    batch_worker(&job);
+    for (int t = 1; t < threads; t++) pthread_join(tid[t], NULL);
+    free(tid);
+}
+
+/*===========================================================================
+ * Timing Utilities
+ *===========================================================================*/
+
+double get_time_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/*===========================================================================
+ * Main
+ *===========================================================================*/
+
+#define CENTRE 1234567u
+
+int main(void) {
+    printf("================================================================\n");
+    printf("  DF2 Disk Coverage as Grid-Cell ID Sets\n");
+    printf("  Direct span export vs rasterize-and-scan\n");
+    printf("================================================================\n\n");
+
+    CellScratch scr;
+    scratch_init(&scr);
+    CellSet a, b, c;
+    cellset_init(&a);
+    cellset_init(&b);
+    cellset_init(&c);
+
+    const char *order_names[] = {"row-major", "Morton"};
+
+    /* Single-disk export */
+    printf("SINGLE-DISK EXPORT:\n");
+    printf("================================================================\n");
+
+    int radii[] = {10, 50, 200};
+    int num_radii = sizeof(radii) / sizeof(radii[0]);
+
+    for (int ri = 0; ri < num_radii; ri++) {
+        int r = radii[ri];
+        DiskQuery q = { CENTRE, CENTRE, r };
+        Framebuffer *fb = fb_create(2 * r + 1, 2 * r + 1);
+        int iterations = 40000 / r;
+
+        printf("\nRadius = %d:\n", r);
+        printf("%-10s %-12s %10s %8s %10s %8s\n",
+               "Order", "Method", "Time(us)", "Runs", "Cells", "Match");
+        printf("----------------------------------------------------------------\n");
+
+        for (int o = 0; o < 2; o++) {
+            CellOrder order = (CellOrder)o;
+
+            double t0 = get_time_ns();
+            for (int i = 0; i < iterations; i++) disk_cells_df2(&q, order, &a, &scr);
+            double t_df2 = (get_time_ns() - t0) / iterations / 1000.0;
+
+            t0 = get_time_ns();
+            for (int i = 0; i < iterations; i++) disk_cells_raster(&q, order, &b, &scr, fb);
+            double t_raster = (get_time_ns() - t0) / iterations / 1000.0;
+
+            int match = cellset_equal(&a, &b);
+            printf("%-10s %-12s %10.2f %8zu %10llu %8s\n", order_names[o],
+                   "DF2 spans", t_df2, a.count,
+                   (unsigned long long)cellset_cells(&a), match ? "yes" : "NO");
+            printf("%-10s %-12s %10.2f %8zu %10llu %8s\n", order_names[o],
+                   "Raster+scan", t_raster, b.count,
+                   (unsigned long long)cellset_cells(&b), "");
+        }
+
+        fb_free(fb);
+    }
+
+    /* Disks clipped by the edges of the 32-bit grid, against the raster */
+    printf("\n\nGRID BOUNDARY (vs per-cell raster reference):\n");
+    printf("================================================================\n");
+    printf("%-10s %-26s %6s %10s %8s\n", "Order", "Centre", "Radius", "Cells", "Match");
+    printf("----------------------------------------------------------------\n");
+
+    int failures = 0;
+    uint32_t edge_centres[][2] = {
+        {0, 0}, {UINT32_MAX, UINT32_MAX}, {4294967290u, 4294967293u}, {UINT32_MAX, 5}
+    };
+    int edge_radii[] = {3, 40};
+    for (int o = 0; o < 2; o++) {
+        for (int ci = 0; ci < 4; ci++) {
+            for (int ri = 0; ri < 2; ri++) {
+                int r = edge_radii[ri];
+                DiskQuery q = { edge_centres[ci][0], edge_centres[ci][1], r };
+                Framebuffer *fb = fb_create(2 * r + 1, 2 * r + 1);
+                disk_cells_df2(&q, (CellOrder)o, &a, &scr);
+                disk_cells_raster(&q, (CellOrder)o, &b, &scr, fb);
+                int match = cellset_equal(&a, &b) &&
+                            cellset_cells(&a) == cellset_cells(&b);
+                failures += !match;
+                char centre[32];
+                snprintf(centre, sizeof(centre), "(%u, %u)", q.cx, q.cy);
+                printf("%-10s %-26s %6d %10llu %8s\n", order_names[o], centre, r,
+                       (unsigned long long)cellset_cells(&a), match ? "yes" : "NO");
+                fb_free(fb);
+            }
+        }
+    }
+
+    /* Every centre in the 16 x 16 block at the top corner of the grid */
+    int sweep = 0, sweep_ok = 0;
+    for (int o = 0; o < 2; o++) {
+        for (uint32_t dy = 0; dy < 16; dy++) {
+            for (uint32_t dx = 0; dx < 16; dx++) {
+                for (int r = 3; r <= 10; r += 7) {
+                    DiskQuery q = { UINT32_MAX - dx, UINT32_MAX - dy, r };
+                    Framebuffer *fb = fb_create(2 * r + 1, 2 * r + 1);
+                    disk_cells_df2(&q, (CellOrder)o, &a, &scr);
+                    disk_cells_raster(&q, (CellOrder)o, &b, &scr, fb);
+                    sweep++;
+                    sweep_ok += cellset_equal(&a, &b);
+                    fb_free(fb);
+                }
+            }
+        }
+    }
+    failures += sweep - sweep_ok;
+    printf("Top-corner sweep: %d of %d disks match\n", sweep_ok, sweep);
+
+    /* Set operations on two overlapping disks */
+    printf("\n\nSET OPERATIONS (two r=100 disks, centres 100 cells apart):\n");
+    printf("================================================================\n");
+    printf("%-10s %-14s %10s %8s %10s\n", "Order", "Operation", "Time(us)",
+           "Runs", "Cells");
+    printf("----------------------------------------------------------------\n");
+
+    for (int o = 0; o < 2; o++) {
+        DiskQuery qa = { CENTRE, CENTRE, 100 };
+        DiskQuery qb = { CENTRE + 100, CENTRE, 100 };
+        disk_cells_df2(&qa, (CellOrder)o, &a, &scr);
+        disk_cells_df2(&qb, (CellOrder)o, &b, &scr);
+        int iterations = 20000;
+
+        double t0 = get_time_ns();
+        for (int i = 0; i < iterations; i++) cellset_union(&a, &b, &c);
+        double t = (get_time_ns() - t0) / iterations / 1000.0;
+        printf("%-10s %-14s %10.2f %8zu %10llu\n", order_names[o], "union", t,
+               c.count, (unsigned long long)cellset_cells(&c));
+
+        t0 = get_time_ns();
+        for (int i = 0; i < iterations; i++) cellset_intersect(&a, &b, &c);
+        t = (get_time_ns() - t0) / iterations / 1000.0;
+        printf("%-10s %-14s %10.2f %8zu %10llu\n", order_names[o], "intersection",
+               t, c.count, (unsigned long long)cellset_cells(&c));
+    }
+
+    /* Batch mode */
+    printf("\n\nBATCH EXPORT (20000 disks, r = 5..50, row-major):\n");
+    printf("================================================================\n");
+    printf("%-10s %12s %14s\n", "Threads", "Time(ms)", "Disks/sec");
+    printf("----------------------------------------------------------------\n");
+
+    int batch = 20000;
+    DiskQuery *queries = malloc(batch * sizeof(DiskQuery));
+    CellSet *sets = malloc(batch * sizeof(CellSet));
+    srand(12345);
+    for (int i = 0; i < batch; i++) {
+        queries[i].cx = (uint32_t)(rand() % 100000);
+        queries[i].cy = (uint32_t)(rand() % 100000);
+        queries[i].r = 5 + rand() % 46;
+        cellset_init(&sets[i]);
+    }
+
+    /* Untimed pass: grow every set once so no timed run pays first allocation */
+    disk_cells_batch(queries, batch, ORDER_ROW_MAJOR, sets, 1);
+
+    int thread_counts[] = {1, 2, 4, 8};
+    for (int ti = 0; ti < 4; ti++) {
+        double t0 = get_time_ns();
+        disk_cells_batch(queries, batch, ORDER_ROW_MAJOR, sets, thread_counts[ti]);
+        double ms = (get_time_ns() - t0) / 1e6;
+        printf("%-10d %12.2f %14.0f\n", thread_counts[ti], ms, batch / (ms / 1000.0));
+    }
+
+    for (int i = 0; i < batch; i++) cellset_free(&sets[i]);
+    free(sets);
+    free(queries);
+
+    cellset_free(&a);
+    cellset_free(&b);
+    cellset_free(&c);
+    scratch_free(&scr);
+
+    printf("\n\nCONCLUSION:\n");
+    printf("================================================================\n");
+    printf("Direct export costs O(r) runs for row-major and O(r log r) block\n");
+    printf("tests for Morton, while the raster baseline touches every pixel\n");
+    printf("of the bounding box (and sorts every cell for Morton).\n");
+
+    return failures ? 1 : 0;
+}
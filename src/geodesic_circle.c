@@ -0,0 +1,522 @@
+/*
+ * DF2 Geodesic Small Circles on Map Projections
+ *
+ * A range ring on the Earth is a small circle on the sphere.  Around its
+ * own centre it is an ordinary circle of angular radius rho, so a DF2 (or
+ * coupled-form) oscillator can generate the bearing cos/sin pairs, and one
+ * fixed affine map per point lifts them onto the sphere:
+ *
+ *   P(b) = cos(rho) * C + sin(rho) * (cos(b) * N + sin(b) * E)
+ *
+ * with C the centre and N, E the local north and east unit vectors.
+ * Projection is then done incrementally from consecutive unit vectors:
+ *
+ *   longitude  += atan(cross / dot)                    (xy-plane turn)
+ *   mercator Y += atanh((z1 - z0) / (1 - z0 * z1))     (atanh addition)
+ *   latitude   += asin(z1 * h0 - z0 * h1), h = cos(lat) (sin subtraction)
+ *
+ * Each increment is small, so a short odd series replaces the trig call.
+ * The bearing step adapts piecewise to the projected ring's curvature, so
+ * every step is a vertex whose chord stays within a pixel tolerance of the
+ * curve.  Compared against per-vertex spherical trigonometry on the same
+ * bearings.
+ *
+ * Compile: gcc -O3 -o geodesic_circle geodesic_circle.c -lm
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <stdint.h>
+
+#define EARTH_RADIUS_M 6371008.8
+#define DEG (M_PI / 180.0)
+
+/*===========================================================================
+ * Types
+ *===========================================================================*/
+
+typedef enum { PROJ_WEB_MERCATOR, PROJ_EQUIRECT } Projection;
+typedef enum { GEN_DF2, GEN_COUPLED } Generator;
+
+typedef struct {
+    double lat, lon;        /* centre, radians */
+    double radius_m;
+} GeoCircle;
+
+typedef struct {
+    Projection proj;
+    double world_px;        /* width of the whole world in pixels (256 * 2^zoom) */
+    double tol_px;          /* max chord-to-curve distance, pixels (> 0) */
+} View;
+
+typedef struct {
+    double x, y;
+} Vec2;
+
+/*===========================================================================
+ * Projection (exact)
+ *
+ * Web Mercator's world is square: Y is clamped to +-pi (lat +-85.05 deg),
+ * which also keeps a ring through a pole finite.
+ *===========================================================================*/
+
+static inline double mercator_clamp(double y) {
+    return y > M_PI ? M_PI : (y < -M_PI ? -M_PI : y);
+}
+
+static inline Vec2 project_exact(const View *v, double lat, double lon) {
+    double k = v->world_px / (2.0 * M_PI);
+    Vec2 p;
+    p.x = (lon + M_PI) * k;
+    if (v->proj == PROJ_WEB_MERCATOR) {
+        p.y = (M_PI - mercator_clamp(atanh(sin(lat)))) * k;
+    } else {
+        p.y = (M_PI / 2 - lat) * k;
+    }
+    return p;
+}
+
+/*===========================================================================
+ * Step Selection
+ *
+ * The ring is split into BEARING_PIECES equal bearing arcs, each walked
+ * with its own step omega.  A chord over a bearing step omega sits at most
+ * omega^2 |v x a| / (8 |v|) from the curve, with v and a the screen-space
+ * velocity and acceleration per unit bearing, so each arc takes the
+ * largest omega that keeps this within tol.  With k = world_px / (2 pi),
+ * z = sin(lat) at the point and lat0 the centre's latitude, Mercator
+ * (conformal) gives exactly
+ *
+ *   |v| = k sin(rho) / cos(lat)
+ *   |v x a| / |v| = k sin(rho) |cos(rho) - z sin(lat0)| / cos^3(lat)
+ *
+ * which for a small ring at the equator is the planar rule omega =
+ * sqrt(8 tol / r), and vanishes for a ring centred on the pole (a straight
+ * line of latitude).  Equirectangular squeezes Mercator vertically by
+ * cos(lat); that adds a term of at most sin(rho) |z| and costs one power of
+ * cos(lat):
+ *
+ *   |v x a| / |v| <= k sin(rho) (|cos(rho) - z sin(lat0)| / cos(lat)
+ *                                + sin(rho) |z|) / cos^2(lat)
+ *
+ * Both are bounded over an arc from its range of z, found in closed form
+ * since z(b) = sin(lat0) cos(rho) + cos(lat0) sin(rho) cos(b) is monotonic
+ * in cos(b): its extremes are at the arc's ends, or at b = 0 or b = pi when
+ * the arc contains them.  The bound uses the latitude the arc actually
+ * reaches, up to a cap: Mercator's clamp at 85.05 deg, past which points
+ * lie on the straight top or bottom edge, and POLE_CAP_LAT for
+ * equirectangular.  Only a ring passing within that cap of a pole, where
+ * the image sweeps through whole degrees of longitude per step, can exceed
+ * the tolerance.
+ *===========================================================================*/
+
+#define BEARING_PIECES 16
+#define POLE_CAP_LAT (89.0 * DEG)
+#define MERCATOR_MAX_LAT 1.48442222974533   /* atan(sinh(pi)), 85.05 deg */
+
+typedef struct {
+    double b0;              /* bearing at the first step */
+    double omega;
+    int steps;
+} BearingPiece;
+
+/* Fills pieces[BEARING_PIECES]; returns the number of vertices (steps + 1) */
+static int bearing_pieces(const GeoCircle *c, const View *v,
+                          BearingPiece *pieces) {
+    double rho = c->radius_m / EARTH_RADIUS_M;
+    double sr = sin(rho), cr = cos(rho), s0 = sin(c->lat);
+    double zc = s0 * cr, zr = cos(c->lat) * sr;
+    double speed = v->world_px / (2.0 * M_PI) * sr;     /* k sin(rho) */
+    int mercator = v->proj == PROJ_WEB_MERCATOR;
+    double zcap = sin(mercator ? MERCATOR_MAX_LAT : POLE_CAP_LAT);
+    double arc = 2.0 * M_PI / BEARING_PIECES;
+    double cos_b0 = 1.0;
+    int total = 0;
+
+    for (int i = 0; i < BEARING_PIECES; i++) {
+        double b0 = i * arc, b1 = b0 + arc;
+        double cos_b1 = cos(b1);
+        double cmax = fmax(cos_b0, cos_b1), cmin = fmin(cos_b0, cos_b1);
+        if (b0 <= 0.0) cmax = 1.0;
+        if (b0 <= M_PI && M_PI <= b1) cmin = -1.0;
+
+        /* z = sin(lat) over the arc, and the worst cos(lat) and curvature term */
+        double za = zc + zr * cmin, zb = zc + zr * cmax;
+        double zhi = fmin(fmax(fabs(za), fabs(zb)), zcap);
+        double chi = sqrt(1.0 - zhi * zhi);
+        double bend = fmax(fabs(cr - za * s0), fabs(cr - zb * s0));
+
+        double sag = mercator ? speed * bend / (chi * chi * chi)
+                              : speed * (bend / chi + sr * zhi) / (chi * chi);
+        double omega = sqrt(8.0 * v->tol_px / sag);
+
+        pieces[i].b0 = b0;
+        pieces[i].steps = (int)ceil(arc / omega);
+        if (pieces[i].steps < 1) pieces[i].steps = 1;
+        pieces[i].omega = arc / pieces[i].steps;
+        total += pieces[i].steps;
+        cos_b0 = cos_b1;
+    }
+    return total + 1;
+}
+
+int geodesic_circle_steps(const GeoCircle *c, const View *v) {
+    BearingPiece pieces[BEARING_PIECES];
+    return bearing_pieces(c, v, pieces);
+}
+
+/*===========================================================================
+ * Incremental Projection Series
+ *
+ * Odd Taylor series for small arguments; callers resynchronize with the
+ * exact function when the argument exceeds SERIES_LIMIT (rings that pass
+ * close to a pole, where longitude turns quickly).
+ *===========================================================================*/
+
+#define SERIES_LIMIT 0.125
+
+static inline double atan_small(double t) {
+    double t2 = t * t;
+    return t * (1.0 + t2 * (-1.0 / 3 + t2 * (1.0 / 5 - t2 * (1.0 / 7))));
+}
+
+static inline double atanh_small(double t) {
+    double t2 = t * t;
+    return t * (1.0 + t2 * (1.0 / 3 + t2 * (1.0 / 5 + t2 * (1.0 / 7))));
+}
+
+static inline double asin_small(double t) {
+    double t2 = t * t;
+    return t * (1.0 + t2 * (1.0 / 6 + t2 * (3.0 / 40 + t2 * (5.0 / 112))));
+}
+
+/*===========================================================================
+ * ALGORITHM 1: Oscillator + Fixed Rotation + Incremental Projection
+ *===========================================================================*/
+
+int geodesic_circle(const GeoCircle *c, const View *v, Generator gen,
+                    Vec2 *out, int max_out) {
+    double rho = c->radius_m / EARTH_RADIUS_M;
+    BearingPiece pieces[BEARING_PIECES];
+    int steps = bearing_pieces(c, v, pieces);
+
+    /* Fixed map: P = A + cos(b) * U + sin(b) * V (six trig calls per ring) */
+    double slat = sin(c->lat), clat = cos(c->lat);
+    double slon = sin(c->lon), clon = cos(c->lon);
+    double sr = sin(rho), cr = cos(rho);
+
+    double ax = cr * clat * clon, ay = cr * clat * slon, az = cr * slat;
+    double ux = -sr * slat * clon, uy = -sr * slat * slon, uz = sr * clat;
+    double vx = -sr * slon, vy = sr * clon;     /* vz = 0 */
+
+    /* Oscillator state, reseeded at the start of each bearing piece */
+    double co = 0, so = 0, coeff = 0, inv_so = 0;
+    double w0 = 0, w1 = 0;          /* DF2: cos(b - omega), cos(b) */
+    double cb = 0, sb = 0;          /* coupled: cos(b), sin(b) */
+    int piece = -1, left = 0;
+
+    double k = v->world_px / (2.0 * M_PI);
+    int mercator = v->proj == PROJ_WEB_MERCATOR;
+
+    int count = 0;
+
+    double px = 0, py = 0, pz = 0, ph = 0;
+    double lon = 0, yproj = 0;
+
+    for (int i = 0; i < steps; i++) {
+        if (left == 0) {
+            /* Four trig calls per piece; the last piece closes the ring */
+            const BearingPiece *bp = &pieces[++piece];
+            co = cos(bp->omega);
+            so = sin(bp->omega);
+            coeff = 2.0 * co;
+            inv_so = 1.0 / so;
+            cb = cos(bp->b0);
+            sb = sin(bp->b0);
+            w1 = cb;
+            w0 = cb * co + sb * so;
+            left = bp->steps + (piece == BEARING_PIECES - 1);
+        }
+        left--;
+
+        double cosb, sinb;
+        if (gen == GEN_DF2) {
+            cosb = w1;
+            sinb = (w0 - w1 * co) * inv_so;
+        } else {
+            cosb = cb;
+            sinb = sb;
+        }
+
+        double x = ax + cosb * ux + sinb * vx;
+        double y = ay + cosb * uy + sinb * vy;
+        double z = az + cosb * uz;
+        double h = mercator ? 0 : sqrt(x * x + y * y);
+
+        if (i == 0) {
+            lon = atan2(y, x);
+            yproj = mercator ? atanh(z) : asin(z);
+        } else {
+            double cross = px * y - py * x, dot = px * x + py * y;
+            double u = mercator ? (z - pz) / (1.0 - pz * z) : z * ph - pz * h;
+
+            /* Series only for a small forward turn; a negative dot product
+             * means the ring jumped past a pole and needs the +-pi branch */
+            if (dot > 0 && fabs(cross) < SERIES_LIMIT * dot) {
+                lon += atan_small(cross / dot);
+            } else {
+                double exact = atan2(y, x);
+                lon += remainder(exact - lon, 2.0 * M_PI);
+            }
+            if (fabs(u) < SERIES_LIMIT) {
+                yproj += mercator ? atanh_small(u) : asin_small(u);
+            } else {
+                yproj = mercator ? atanh(z) : asin(z);
+            }
+        }
+
+        Vec2 p;
+        p.x = (lon + M_PI) * k;
+        p.y = (mercator ? M_PI - mercator_clamp(yproj) : M_PI / 2 - yproj) * k;
+        if (count < max_out) out[count++] = p;
+
+        px = x;
+        py = y;
+        pz = z;
+        ph = h;
+
+        if (gen == GEN_DF2) {
+            double w2 = coeff * w1 - w0;
+            w0 = w1;
+            w1 = w2;
+        } else {
+            double cn = cb * co - sb * so;
+            double sn = cb * so + sb * co;
+            cb = cn;
+            sb = sn;
+        }
+    }
+
+    return count;
+}
+
+/*===========================================================================
+ * ALGORITHM 2: Per-Vertex Spherical Trigonometry (baseline)
+ *
+ * Destination point from the centre at bearing b, angular distance rho:
+ *   lat = asin(sin(lat0) cos(rho) + cos(lat0) sin(rho) cos(b))
+ *   lon = lon0 + atan2(sin(b) sin(rho) cos(lat0), cos(rho) - sin(lat0) sin(lat))
+ * then the exact projection.  Evaluated only at the bearings Algorithm 1
+ * walks, so both produce one vertex per step of the same schedule.
+ *===========================================================================*/
+
+int geodesic_circle_trig(const GeoCircle *c, const View *v, Vec2 *out,
+                         int max_out) {
+    double rho = c->radius_m / EARTH_RADIUS_M;
+    BearingPiece pieces[BEARING_PIECES];
+    bearing_pieces(c, v, pieces);
+
+    double slat0 = sin(c->lat), clat0 = cos(c->lat);
+    double sr = sin(rho), cr = cos(rho);
+
+    int count = 0;
+
+    for (int pi = 0; pi < BEARING_PIECES; pi++) {
+        int n = pieces[pi].steps + (pi == BEARING_PIECES - 1);
+        for (int i = 0; i < n; i++) {
+            double b = pieces[pi].b0 + i * pieces[pi].omega;
+            double lat = asin(slat0 * cr + clat0 * sr * cos(b));
+            double lon = c->lon + atan2(sin(b) * sr * clat0, cr - slat0 * sin(lat));
+            if (count < max_out) out[count++] = project_exact(v, lat, lon);
+        }
+    }
+
+    return count;
+}
+
+/*===========================================================================
+ * Timing Utilities
+ *===========================================================================*/
+
+double get_time_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/*===========================================================================
+ * Benchmark Infrastructure
+ *===========================================================================*/
+
+typedef struct {
+    const char *name;
+    double lat_deg, lon_deg, radius_km;
+    Projection proj;
+    int zoom;
+} Case;
+
+#define TOL_PX 0.25
+
+static View case_view(const Case *cs) {
+    View v = { cs->proj, 256.0 * (1 << cs->zoom), TOL_PX };
+    return v;
+}
+
+/* Max screen-space distance between matching vertices */
+static double max_error_px(const Case *cs, Generator gen) {
+    GeoCircle c = { cs->lat_deg * DEG, cs->lon_deg * DEG, cs->radius_km * 1000 };
+    View v = case_view(cs);
+    int steps = geodesic_circle_steps(&c, &v);
+
+    Vec2 *a = malloc(steps * sizeof(Vec2));
+    Vec2 *b = malloc(steps * sizeof(Vec2));
+    int na = geodesic_circle(&c, &v, gen, a, steps);
+    int nb = geodesic_circle_trig(&c, &v, b, steps);
+
+    /* Incremental longitude is unwrapped; compare modulo one world width */
+    double worst = 0;
+    for (int i = 0; i < na && i < nb; i++) {
+        double dx = remainder(a[i].x - b[i].x, v.world_px);
+        double d = hypot(dx, a[i].y - b[i].y);
+        if (d > worst) worst = d;
+    }
+
+    free(a);
+    free(b);
+    return worst;
+}
+
+/*
+ * Largest distance from a chord of the schedule to the exact projected
+ * curve between its ends, sampled at SAG_SAMPLES bearings per step.
+ */
+#define SAG_SAMPLES 8
+
+static Vec2 exact_point(const GeoCircle *c, const View *v, double b) {
+    double rho = c->radius_m / EARTH_RADIUS_M;
+    double lat = asin(sin(c->lat) * cos(rho) + cos(c->lat) * sin(rho) * cos(b));
+    double lon = c->lon + atan2(sin(b) * sin(rho) * cos(c->lat),
+                                cos(rho) - sin(c->lat) * sin(lat));
+    return project_exact(v, lat, lon);
+}
+
+static double max_sagitta_px(const Case *cs) {
+    GeoCircle c = { cs->lat_deg * DEG, cs->lon_deg * DEG, cs->radius_km * 1000 };
+    View v = case_view(cs);
+    BearingPiece pieces[BEARING_PIECES];
+    bearing_pieces(&c, &v, pieces);
+
+    double worst = 0;
+    for (int pi = 0; pi < BEARING_PIECES; pi++) {
+        for (int i = 0; i < pieces[pi].steps; i++) {
+            double b = pieces[pi].b0 + i * pieces[pi].omega;
+            Vec2 a = exact_point(&c, &v, b);
+            Vec2 q = exact_point(&c, &v, b + pieces[pi].omega);
+            double tx = remainder(q.x - a.x, v.world_px), ty = q.y - a.y;
+            double len = hypot(tx, ty);
+            for (int j = 1; j < SAG_SAMPLES; j++) {
+                Vec2 m = exact_point(&c, &v, b + pieces[pi].omega * j / SAG_SAMPLES);
+                double mx = remainder(m.x - a.x, v.world_px), my = m.y - a.y;
+                double d = len > 0 ? fabs(mx * ty - my * tx) / len : hypot(mx, my);
+                if (d > worst) worst = d;
+            }
+        }
+    }
+    return worst;
+}
+
+static double time_us(const Case *cs, int method, int iterations, int *verts) {
+    GeoCircle c = { cs->lat_deg * DEG, cs->lon_deg * DEG, cs->radius_km * 1000 };
+    View v = case_view(cs);
+    int steps = geodesic_circle_steps(&c, &v);
+    Vec2 *out = malloc(steps * sizeof(Vec2));
+
+    double start = get_time_ns();
+    for (int i = 0; i < iterations; i++) {
+        if (method == 0) *verts = geodesic_circle_trig(&c, &v, out, steps);
+        else *verts = geodesic_circle(&c, &v, method == 1 ? GEN_DF2 : GEN_COUPLED,
+                                      out, steps);
+    }
+    double t = (get_time_ns() - start) / iterations / 1000.0;
+
+    free(out);
+    return t;
+}
+
+/*===========================================================================
+ * Main
+ *===========================================================================*/
+
+int main(void) {
+    printf("================================================================\n");
+    printf("  DF2 Geodesic Small Circles on Map Projections\n");
+    printf("  Oscillator + fixed rotation vs per-vertex spherical trig\n");
+    printf("================================================================\n\n");
+
+    Case cases[] = {
+        {"London 50 km, z10", 51.5, -0.13, 50, PROJ_WEB_MERCATOR, 10},
+        {"London 500 km, z6", 51.5, -0.13, 500, PROJ_WEB_MERCATOR, 6},
+        {"Tromso 1000 km, z5", 69.6, 18.9, 1000, PROJ_WEB_MERCATOR, 5},
+        {"Fiji 800 km, z6 (180 deg)", -17.7, 178.1, 800, PROJ_WEB_MERCATOR, 6},
+        {"Equator 5 km, z14", 0.0, 30.0, 5, PROJ_WEB_MERCATOR, 14},
+        {"London 500 km, z6", 51.5, -0.13, 500, PROJ_EQUIRECT, 6},
+        {"Svalbard 1500 km, z4 (pole)", 78.2, 15.6, 1500, PROJ_EQUIRECT, 4},
+        {"88N 300 km, z6 (pole)", 88.0, 0.0, 300, PROJ_EQUIRECT, 6},
+        {"80N 10E 10 deg, z4 (tangent)", 80.0, 10.0, 1111.95, PROJ_EQUIRECT, 4},
+        {"80N 10E 10 deg, z4 (tangent)", 80.0, 10.0, 1111.95, PROJ_WEB_MERCATOR, 4}
+    };
+    int num_cases = sizeof(cases) / sizeof(cases[0]);
+    const char *proj_names[] = {"Mercator", "Equirect"};
+
+    printf("ACCURACY (tolerance %.2f px; vertex error vs spherical trig and\n", TOL_PX);
+    printf("          worst chord-to-curve distance, pixels):\n");
+    printf("=========================================================================\n");
+    printf("%-30s %-9s %8s %10s %10s %8s\n", "Ring", "Proj", "Steps", "DF2",
+           "Coupled", "Sagitta");
+    printf("-------------------------------------------------------------------------\n");
+    for (int i = 0; i < num_cases; i++) {
+        GeoCircle c = { cases[i].lat_deg * DEG, cases[i].lon_deg * DEG,
+                        cases[i].radius_km * 1000 };
+        View v = case_view(&cases[i]);
+        printf("%-30s %-9s %8d %10.2e %10.2e %8.3f\n", cases[i].name,
+               proj_names[cases[i].proj], geodesic_circle_steps(&c, &v),
+               max_error_px(&cases[i], GEN_DF2),
+               max_error_px(&cases[i], GEN_COUPLED),
+               max_sagitta_px(&cases[i]));
+    }
+
+    printf("\n\nPERFORMANCE (same bearing schedule for all three):\n");
+    printf("================================================================\n");
+    printf("%-30s %-9s %9s %9s %9s %7s %8s\n", "Ring", "Proj", "Trig(us)",
+           "DF2(us)", "Coupled", "Verts", "Speedup");
+    printf("----------------------------------------------------------------\n");
+    double min_speedup = 1e9, max_speedup = 0;
+    for (int i = 0; i < num_cases; i++) {
+        int iterations = 300;
+        int vt, vd, vc;
+        double tt = time_us(&cases[i], 0, iterations, &vt);
+        double td = time_us(&cases[i], 1, iterations, &vd);
+        double tc = time_us(&cases[i], 2, iterations, &vc);
+        printf("%-30s %-9s %9.2f %9.2f %9.2f %7d %7.1fx\n", cases[i].name,
+               proj_names[cases[i].proj], tt, td, tc, vd, tt / td);
+        if (tt / td < min_speedup) min_speedup = tt / td;
+        if (tt / td > max_speedup) max_speedup = tt / td;
+    }
+
+    printf("\n\nCONCLUSION:\n");
+    printf("================================================================\n");
+    printf("Per ring, setup is about %d trig calls: six for the fixed map,\n",
+           6 + 5 + 5 * BEARING_PIECES);
+    printf("one cos and a few square roots per bearing piece for its step,\n");
+    printf("and four to reseed the oscillator on each of the %d pieces.\n",
+           BEARING_PIECES);
+    printf("After that each vertex costs a handful of multiplies and a short\n");
+    printf("series.  On the same tolerance-driven schedule this is %.1fx-%.1fx\n",
+           min_speedup, max_speedup);
+    printf("faster than spherical trig per vertex here.\n");
+
+    return 0;
+}
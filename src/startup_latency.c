@@ -0,0 +1,613 @@
+/*
+ * DF2 Startup and First-Frame Latency
+ *
+ * Renderers spawned per request pay their cold-start cost on every job,
+ * and the other benchmarks never see it: thousands of iterations leave
+ * caches, TLBs and branch predictors warm.  This benchmark execs a fresh
+ * copy of itself for every sample and times, inside the child:
+ *
+ *   start   parent's spawn call -> child's main()  (exec, loader, libc)
+ *   alloc   framebuffer allocation
+ *   touch   first write over the framebuffer, with its minor page faults
+ *   init    coefficient / table setup for the algorithm
+ *   first   the first circle drawn
+ *   warm    mean of later draws in the same process
+ *
+ * for each algorithm and pixel-format backend (8bpp mask, 32bpp RGBA).
+ *
+ * The built-in kernels are split into setup and draw so the two can be
+ * timed apart; the Sine LUT kernel's setup is building its table.  Kernels loaded from shared objects (--kernel PATH,
+ * DF2_KERNELS) are timed too: their init phase is loading the plugin
+ * through the registry, and they run on the 8bpp backend only, since the
+ * df2_kernel.h ABI draws into an 8bpp Framebuffer.
+ *
+ * Compile: gcc -O3 -o startup_latency startup_latency.c -lm -ldl
+ */
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <sys/resource.h>
+
+#include "df2_kernel.h"
+#include "df2_registry.h"
+#include "df2_lut.h"
+
+extern char **environ;
+
+/*===========================================================================
+ * Surface (8bpp mask or 32bpp RGBA)
+ *
+ * An 8bpp surface is handed to plugin kernels as a df2_kernel.h
+ * Framebuffer through surf_as_fb().
+ *===========================================================================*/
+
+typedef struct {
+    int width, height;
+    int bpp;
+    uint8_t *pixels;
+} Surface;
+
+Surface* surf_create(int w, int h, int bpp) {
+    Surface *sf = malloc(sizeof(Surface));
+    sf->width = w;
+    sf->height = h;
+    sf->bpp = bpp;
+    sf->pixels = calloc((size_t)w * h, bpp);
+    return sf;
+}
+
+void surf_clear(Surface *sf) {
+    memset(sf->pixels, 0, (size_t)sf->width * sf->height * sf->bpp);
+}
+
+void surf_free(Surface *sf) {
+    free(sf->pixels);
+    free(sf);
+}
+
+static inline Framebuffer surf_as_fb(const Surface *sf) {
+    Framebuffer fb = {sf->width, sf->height, sf->pixels};
+    return fb;
+}
+
+static inline void surf_plot(Surface *sf, int x, int y) {
+    x += sf->width / 2;
+    y += sf->height / 2;
+    if (x >= 0 && x < sf->width && y >= 0 && y < sf->height) {
+        size_t i = (size_t)y * sf->width + x;
+        if (sf->bpp == 1) sf->pixels[i] = 1;
+        else ((uint32_t *)sf->pixels)[i] = 0xFFFFFFFFu;
+    }
+}
+
+static inline void surf_plot8(Surface *sf, int cx, int cy, int x, int y) {
+    surf_plot(sf, cx + x, cy + y);
+    surf_plot(sf, cx - x, cy + y);
+    surf_plot(sf, cx + x, cy - y);
+    surf_plot(sf, cx - x, cy - y);
+    surf_plot(sf, cx + y, cy + x);
+    surf_plot(sf, cx - y, cy + x);
+    surf_plot(sf, cx + y, cy - x);
+    surf_plot(sf, cx - y, cy - x);
+}
+
+/*===========================================================================
+ * Algorithms, split into coefficient/table setup and drawing
+ *
+ * Setup is what a cold process pays once per radius; draw is the loop the
+ * warm benchmarks measure.
+ *===========================================================================*/
+
+typedef struct {
+    double coeff, scale, w0, w1;        /* float kernels */
+    fixed_t qcoeff, qscale, qw0, qw1;   /* fixed-point kernels */
+    uint64_t dphase;                    /* sine table kernel */
+    int steps;
+} Coeffs;
+
+static void init_df2_float(Coeffs *k, int r) {
+    double omega = 1.0 / (1.5 * r);
+    k->coeff = 2.0 * cos(omega);
+    k->scale = -1.0 / omega;
+    k->w0 = r * cos(omega);
+    k->w1 = r;
+}
+
+static void draw_df2_float(Surface *sf, int r, const Coeffs *k) {
+    double coeff = k->coeff, scale = k->scale, w0 = k->w0, w1 = k->w1;
+    (void)r;
+    while (1) {
+        int x = (int)round(w1);
+        int y = (int)round((w1 - w0) * scale);
+        if (y > x) break;
+        surf_plot8(sf, 0, 0, x, y);
+        double w2 = coeff * w1 - w0;
+        w0 = w1;
+        w1 = w2;
+    }
+}
+
+static void init_df2_fixed(Coeffs *k, int r) {
+    double omega = 1.0 / (1.5 * r);
+    k->qcoeff = to_fixed(2.0 * cos(omega));
+    k->qscale = to_fixed(-1.0 / omega);
+    k->qw0 = to_fixed(r * cos(omega));
+    k->qw1 = to_fixed((double)r);
+}
+
+static void draw_df2_fixed(Surface *sf, int r, const Coeffs *k) {
+    fixed_t coeff = k->qcoeff, scale = k->qscale, w0 = k->qw0, w1 = k->qw1;
+    (void)r;
+    while (1) {
+        int x = fixed_to_int(w1);
+        int y = fixed_to_int(fp_mul(w1 - w0, scale));
+        if (y > x) break;
+        surf_plot8(sf, 0, 0, x, y);
+        fixed_t w2 = fp_mul(coeff, w1) - w0;
+        w0 = w1;
+        w1 = w2;
+    }
+}
+
+static void init_coupled_float(Coeffs *k, int r) {
+    double omega = 1.0 / (1.5 * r);
+    k->coeff = cos(omega);
+    k->scale = sin(omega);
+    k->w1 = r;
+    k->w0 = 0;
+}
+
+static void draw_coupled_float(Surface *sf, int r, const Coeffs *k) {
+    double c = k->coeff, s = k->scale, x = k->w1, y = k->w0;
+    (void)r;
+    while (1) {
+        int ix = (int)round(x);
+        int iy = (int)round(y);
+        if (iy > ix) break;
+        surf_plot8(sf, 0, 0, ix, iy);
+        double xn = x * c - y * s;
+        double yn = x * s + y * c;
+        x = xn;
+        y = yn;
+    }
+}
+
+static void init_coupled_fixed(Coeffs *k, int r) {
+    double omega = 1.0 / (1.5 * r);
+    k->qcoeff = to_fixed(cos(omega));
+    k->qscale = to_fixed(sin(omega));
+    k->qw1 = to_fixed((double)r);
+    k->qw0 = 0;
+}
+
+static void draw_coupled_fixed(Surface *sf, int r, const Coeffs *k) {
+    fixed_t c = k->qcoeff, s = k->qscale, x = k->qw1, y = k->qw0;
+    (void)r;
+    while (1) {
+        int ix = fixed_to_int(x);
+        int iy = fixed_to_int(y);
+        if (iy > ix) break;
+        surf_plot8(sf, 0, 0, ix, iy);
+        fixed_t xn = fp_mul(x, c) - fp_mul(y, s);
+        fixed_t yn = fp_mul(x, s) + fp_mul(y, c);
+        x = xn;
+        y = yn;
+    }
+}
+
+/* Table build is the setup a cold process pays; df2_benchmark does it at
+ * registration, outside its timings. */
+static void init_lut(Coeffs *k, int r) {
+    sin_lut_init();
+    double omega = 1.0 / (1.5 * r);
+    k->dphase = (uint64_t)(omega / (2.0 * M_PI) * 18446744073709551616.0 + 0.5);
+    k->steps = (int)(2.0 * M_PI / omega) + 1;
+}
+
+static void draw_lut(Surface *sf, int r, const Coeffs *k) {
+    uint64_t phase = 0;
+    for (int i = 0; i < k->steps; i++) {
+        uint32_t p = (uint32_t)(phase >> 32);
+        int x = (int)round(r * lut_sin(p + 0x40000000u));
+        int y = (int)round(r * lut_sin(p));
+        surf_plot(sf, x, y);
+        phase += k->dphase;
+    }
+}
+
+static void init_none(Coeffs *k, int r) {
+    (void)k;
+    (void)r;
+}
+
+static void draw_bresenham(Surface *sf, int r, const Coeffs *k) {
+    int x = 0, y = r, d = 3 - 2 * r;
+    (void)k;
+    while (x <= y) {
+        surf_plot8(sf, 0, 0, x, y);
+        if (d < 0) {
+            d = d + 4 * x + 6;
+        } else {
+            d = d + 4 * (x - y) + 10;
+            y--;
+        }
+        x++;
+    }
+}
+
+/* df2_benchmark's octant built-ins, plus the one kernel with a table */
+typedef struct {
+    const char *name;
+    void (*init)(Coeffs *, int);
+    void (*draw)(Surface *, int, const Coeffs *);
+} SplitKernel;
+
+static const SplitKernel builtins[] = {
+    {"DF2 Float", init_df2_float, draw_df2_float},
+    {"DF2 Fixed (Q16.16)", init_df2_fixed, draw_df2_fixed},
+    {"Coupled Float", init_coupled_float, draw_coupled_float},
+    {"Coupled Fixed (Q16.16)", init_coupled_fixed, draw_coupled_fixed},
+    {"Bresenham", init_none, draw_bresenham},
+    {"Sine LUT (full)", init_lut, draw_lut}
+};
+#define NUM_BUILTINS ((int)(sizeof(builtins) / sizeof(builtins[0])))
+#define MAX_ALGS (NUM_BUILTINS + MAX_KERNELS)
+
+static const struct { const char *name; int bpp; } backends[] = {
+    {"8bpp", 1},
+    {"RGBA32", 4}
+};
+#define NUM_BACKENDS ((int)(sizeof(backends) / sizeof(backends[0])))
+
+/*===========================================================================
+ * Timing Utilities
+ *
+ * CLOCK_MONOTONIC is system-wide, so a timestamp taken by the parent just
+ * before spawning can be compared with one taken in the child's main().
+ *===========================================================================*/
+
+double get_time_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static long minor_faults(void) {
+    struct rusage ru;
+    getrusage(RUSAGE_SELF, &ru);
+    return ru.ru_minflt;
+}
+
+/*===========================================================================
+ * Child: one cold start
+ *
+ * Rows 0 .. NUM_BUILTINS-1 are the split built-ins; row NUM_BUILTINS + j
+ * is kernel j of the plugins named after the timestamp, loaded in order.
+ *===========================================================================*/
+
+#define FB_SIZE 1024
+#define RADIUS 100
+#define WARM_ITERS 2000
+
+typedef struct {
+    double start_us, alloc_us, touch_us, init_us, first_us, warm_us;
+    long faults;
+} Sample;
+
+/* Parses a non-negative decimal index below limit; -1 if malformed */
+static int parse_index(const char *s, int limit) {
+    char *end;
+    long v = strtol(s, &end, 10);
+    if (end == s || *end != '\0' || v < 0 || v >= limit) return -1;
+    return (int)v;
+}
+
+static int run_child(int alg, int backend, double t_spawn,
+                     char **plugins, int num_plugins) {
+    double t_main = get_time_ns();
+    static Registry reg;
+    const SplitKernel *a = alg < NUM_BUILTINS ? &builtins[alg] : NULL;
+    Sample s;
+
+    if (!a && backends[backend].bpp != 1) {
+        fprintf(stderr, "plugin kernels draw 8bpp only\n");
+        return 2;
+    }
+
+    s.start_us = (t_main - t_spawn) / 1000.0;
+
+    double t = get_time_ns();
+    Surface *sf = surf_create(FB_SIZE, FB_SIZE, backends[backend].bpp);
+    s.alloc_us = (get_time_ns() - t) / 1000.0;
+
+    long f0 = minor_faults();
+    t = get_time_ns();
+    surf_clear(sf);
+    s.touch_us = (get_time_ns() - t) / 1000.0;
+    s.faults = minor_faults() - f0;
+
+    /* Init: coefficients or table for a built-in, dlopen and binding for a plugin */
+    Coeffs k;
+    t = get_time_ns();
+    if (a) {
+        a->init(&k, RADIUS);
+    } else {
+        for (int i = 0; i < num_plugins; i++) registry_load(&reg, plugins[i]);
+    }
+    s.init_us = (get_time_ns() - t) / 1000.0;
+
+    const Algorithm *p = NULL;
+    if (!a) {
+        if (alg - NUM_BUILTINS >= reg.count) {
+            fprintf(stderr, "kernel %d not found in %d plugin(s)\n", alg, num_plugins);
+            surf_free(sf);
+            return 2;
+        }
+        p = &reg.kernels[alg - NUM_BUILTINS];
+    }
+    Framebuffer fb = surf_as_fb(sf);
+
+    t = get_time_ns();
+    if (a) a->draw(sf, RADIUS, &k);
+    else p->func(&fb, 0, 0, RADIUS);
+    s.first_us = (get_time_ns() - t) / 1000.0;
+
+    /* Warm: same process, coefficients and tables cached, code and data hot */
+    double total = 0;
+    for (int i = 0; i < WARM_ITERS; i++) {
+        t = get_time_ns();
+        if (a) a->draw(sf, RADIUS, &k);
+        else p->func(&fb, 0, 0, RADIUS);
+        total += get_time_ns() - t;
+    }
+    s.warm_us = total / WARM_ITERS / 1000.0;
+
+    surf_free(sf);
+    registry_close(&reg);
+
+    printf("%.3f %.3f %.3f %.3f %.3f %.4f %ld\n", s.start_us, s.alloc_us,
+           s.touch_us, s.init_us, s.first_us, s.warm_us, s.faults);
+    return 0;
+}
+
+/*===========================================================================
+ * Parent: spawn one child per sample
+ *===========================================================================*/
+
+static int spawn_sample(const char *exe, int alg, int backend,
+                        char **plugins, int num_plugins, Sample *s) {
+    int fd[2];
+    if (pipe(fd) != 0) return -1;
+
+    posix_spawn_file_actions_t fa;
+    posix_spawn_file_actions_init(&fa);
+    posix_spawn_file_actions_adddup2(&fa, fd[1], STDOUT_FILENO);
+    posix_spawn_file_actions_addclose(&fa, fd[0]);
+
+    char a_arg[16], b_arg[16], t_arg[32];
+    snprintf(a_arg, sizeof(a_arg), "%d", alg);
+    snprintf(b_arg, sizeof(b_arg), "%d", backend);
+
+    char *argv[6 + MAX_PLUGINS];
+    int argn = 0;
+    argv[argn++] = (char *)exe;
+    argv[argn++] = "--child";
+    argv[argn++] = a_arg;
+    argv[argn++] = b_arg;
+    argv[argn++] = t_arg;
+    for (int i = 0; i < num_plugins; i++) argv[argn++] = plugins[i];
+    argv[argn] = NULL;
+
+    double t_spawn = get_time_ns();
+    snprintf(t_arg, sizeof(t_arg), "%.0f", t_spawn);
+
+    pid_t pid;
+    int err = posix_spawn(&pid, exe, &fa, NULL, argv, environ);
+    posix_spawn_file_actions_destroy(&fa);
+    close(fd[1]);
+    if (err != 0) {
+        close(fd[0]);
+        return -1;
+    }
+
+    char buf[256];
+    ssize_t n, len = 0;
+    while (len < (ssize_t)sizeof(buf) - 1 &&
+           (n = read(fd[0], buf + len, sizeof(buf) - 1 - len)) > 0) {
+        len += n;
+    }
+    buf[len] = '\0';
+    close(fd[0]);
+
+    int status;
+    waitpid(pid, &status, 0);
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) return -1;
+
+    return sscanf(buf, "%lf %lf %lf %lf %lf %lf %ld", &s->start_us, &s->alloc_us,
+                  &s->touch_us, &s->init_us, &s->first_us, &s->warm_us,
+                  &s->faults) == 7 ? 0 : -1;
+}
+
+static int cmp_double(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static double median(double *v, int n) {
+    qsort(v, n, sizeof(double), cmp_double);
+    return n & 1 ? v[n / 2] : 0.5 * (v[n / 2 - 1] + v[n / 2]);
+}
+
+/*===========================================================================
+ * Main
+ *===========================================================================*/
+
+#define SAMPLES 21
+
+int main(int argc, char **argv) {
+    if (argc >= 5 && strcmp(argv[1], "--child") == 0) {
+        int num_plugins = argc - 5;
+        int alg = parse_index(argv[2], NUM_BUILTINS + MAX_KERNELS);
+        int backend = parse_index(argv[3], NUM_BACKENDS);
+        if (alg < 0 || backend < 0 || num_plugins > MAX_PLUGINS) {
+            fprintf(stderr, "--child: bad kernel '%s' or backend '%s'\n",
+                    argv[2], argv[3]);
+            return 2;
+        }
+        return run_child(alg, backend, atof(argv[4]), argv + 5, num_plugins);
+    }
+
+    /*
+     * Plugins: DF2_KERNELS, then --kernel, as in df2_benchmark.  The parent
+     * loads them once for names and capabilities; each child loads them
+     * again from the paths it is given, never from the environment.
+     */
+    static Registry reg;
+    char *plugins[MAX_PLUGINS];
+    int num_plugins = 0;
+    char *paths[MAX_PLUGINS + 1];
+    int num_paths = 0;
+
+    const char *list = getenv("DF2_KERNELS");
+    if (list && *list) {
+        char *copy = strdup(list);
+        for (char *path = strtok(copy, ":"); path && num_paths <= MAX_PLUGINS;
+             path = strtok(NULL, ":")) {
+            paths[num_paths++] = path;
+        }
+    }
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--kernel") == 0 && i + 1 < argc) {
+            if (num_paths <= MAX_PLUGINS) paths[num_paths++] = argv[++i];
+            else i++;
+        } else {
+            fprintf(stderr, "usage: %s [--kernel PATH.so]...\n", argv[0]);
+            return 1;
+        }
+    }
+    for (int i = 0; i < num_paths; i++) {
+        if (registry_load(&reg, paths[i]) >= 0) plugins[num_plugins++] = paths[i];
+    }
+
+    /* Rows: every built-in, then plugin kernels that can run at RADIUS here */
+    const char *names[MAX_ALGS];
+    int rows[MAX_ALGS];
+    int num_rows = 0;
+    for (int ai = 0; ai < NUM_BUILTINS; ai++) {
+        names[num_rows] = builtins[ai].name;
+        rows[num_rows++] = ai;
+    }
+    for (int j = 0; j < reg.count; j++) {
+        const Algorithm *k = &reg.kernels[j];
+        if (!isa_supported(k->isa) || !kernel_supports_radius(k, RADIUS)) {
+            printf("skipping %s: not usable at r=%d on this CPU\n", k->name, RADIUS);
+            continue;
+        }
+        names[num_rows] = k->name;
+        rows[num_rows++] = NUM_BUILTINS + j;
+    }
+
+    /* Re-exec the exact binary that is running, wherever it was started */
+    char exe[4096];
+    ssize_t n = readlink("/proc/self/exe", exe, sizeof(exe) - 1);
+    if (n > 0) exe[n] = '\0';
+    else snprintf(exe, sizeof(exe), "%s", argv[0]);
+
+    printf("================================================================\n");
+    printf("  DF2 Startup and First-Frame Latency\n");
+    printf("  One fresh process per sample, median of %d\n", SAMPLES);
+    printf("================================================================\n\n");
+    printf("Framebuffer %dx%d, radius %d, warm = mean of %d draws\n",
+           FB_SIZE, FB_SIZE, RADIUS, WARM_ITERS);
+    printf("Plugin kernels: init = loading their objects, 8bpp backend only\n\n");
+
+    printf("PHASE BREAKDOWN (us):\n");
+    printf("=============================================================================================\n");
+    printf("%-24s %-7s %8s %8s %8s %7s %7s %8s %8s %8s\n", "Algorithm", "Backend",
+           "Start", "Alloc", "Touch", "Faults", "Init", "First", "Warm", "Cold/Warm");
+    printf("---------------------------------------------------------------------------------------------\n");
+
+    double first_pixel[MAX_ALGS][NUM_BACKENDS];
+    int failures = 0;
+
+    for (int ri = 0; ri < num_rows; ri++) {
+        int ai = rows[ri];
+        for (int bi = 0; bi < NUM_BACKENDS; bi++) {
+            double start[SAMPLES], alloc[SAMPLES], touch[SAMPLES], faults[SAMPLES];
+            double init[SAMPLES], first[SAMPLES], warm[SAMPLES];
+            int got = 0;
+
+            if (ai >= NUM_BUILTINS && backends[bi].bpp != 1) {
+                first_pixel[ri][bi] = -1;
+                continue;
+            }
+
+            for (int i = 0; i < SAMPLES; i++) {
+                Sample s;
+                if (spawn_sample(exe, ai, bi, plugins, num_plugins, &s) != 0) continue;
+                start[got] = s.start_us;
+                alloc[got] = s.alloc_us;
+                touch[got] = s.touch_us;
+                faults[got] = s.faults;
+                init[got] = s.init_us;
+                first[got] = s.first_us;
+                warm[got] = s.warm_us;
+                got++;
+            }
+
+            if (got == 0) {
+                printf("%-24s %-7s %8s\n", names[ri], backends[bi].name, "FAILED");
+                first_pixel[ri][bi] = 0;
+                failures++;
+                continue;
+            }
+
+            double m_start = median(start, got), m_alloc = median(alloc, got);
+            double m_touch = median(touch, got), m_faults = median(faults, got);
+            double m_init = median(init, got), m_first = median(first, got);
+            double m_warm = median(warm, got);
+
+            first_pixel[ri][bi] = m_start + m_alloc + m_touch + m_init + m_first;
+
+            printf("%-24s %-7s %8.1f %8.1f %8.1f %7.0f %7.2f %8.2f %8.2f %8.1fx\n",
+                   names[ri], backends[bi].name, m_start, m_alloc,
+                   m_touch, m_faults, m_init, m_first, m_warm, m_first / m_warm);
+        }
+    }
+
+    printf("\n\nTIME TO FIRST CIRCLE (us, spawn -> first draw complete):\n");
+    printf("====================================================================\n");
+    printf("%-24s", "Algorithm");
+    for (int bi = 0; bi < NUM_BACKENDS; bi++) printf(" %12s", backends[bi].name);
+    printf("\n--------------------------------------------------------------------\n");
+    for (int ri = 0; ri < num_rows; ri++) {
+        printf("%-24s", names[ri]);
+        for (int bi = 0; bi < NUM_BACKENDS; bi++) {
+            if (first_pixel[ri][bi] < 0) printf(" %12s", "-");
+            else printf(" %12.1f", first_pixel[ri][bi]);
+        }
+        printf("\n");
+    }
+
+    printf("\n\nCONCLUSION:\n");
+    printf("================================================================\n");
+    printf("For a spawned renderer the circle itself is a small share of\n");
+    printf("time to first frame: exec and first-touch page faults dominate,\n");
+    printf("and coefficient or table setup pays for first-call libm binding.\n");
+    if (num_plugins > 0) {
+        printf("A plugin kernel adds its dlopen and relocation to that, once\n");
+        printf("per process, on top of the same exec and page-fault cost.\n");
+    }
+
+    registry_close(&reg);
+    return failures ? 1 : 0;
+}